@@ -0,0 +1,282 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Memory/FrameAllocator.h"
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Memory/HugePageAllocator.h"
+#include "Core/Memory/LinearAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/ProxyAllocator.h"
+#include "Core/Memory/TempAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+#include "Core/Memory/TrackingAllocator.h"
+#include "Core/Memory/VirtualArenaAllocator.h"
+
+#include <stdio.h> // fprintf
+#include <string.h> // memset
+
+namespace Rio
+{
+
+namespace AlignmentCheckInternalFn
+{
+	const uint32_t ALIGN_LIST[] = { 16, 32, 64, 128 };
+	const uint32_t SIZE_LIST[] = { 1, 16, 24, 100, 1000, 5000, 70000, 3 * 1024 * 1024 }; // Up to past the size classes and the huge page threshold
+	const uint32_t MAX_BLOCK_COUNT = countof(ALIGN_LIST) * countof(SIZE_LIST);
+
+	// Allocator under check, with the requests it is able to serve
+	struct Subject
+	{
+		const char* name = nullptr;
+		Allocator* allocator = nullptr;
+		uint32_t maxSize = 3 * 1024 * 1024;
+		uint32_t maxAlign = 128;
+		bool canDeallocate = true;
+		bool hasMemoryHeader = false; // Whether blocks start with a Memory::Header found by Memory::getHeader()
+	};
+
+	// Grows a block at every alignment the subject supports, checking that it stays aligned and keeps its content
+	static void checkReallocate(const Subject& subject)
+	{
+		Allocator& allocator = *subject.allocator;
+
+		for (uint32_t i = 0; i < countof(ALIGN_LIST); ++i)
+		{
+			const uint32_t align = ALIGN_LIST[i];
+			if (align > subject.maxAlign)
+			{
+				continue;
+			}
+
+			uint32_t size = 24;
+			unsigned char* data = (unsigned char*)allocator.allocate(size, align);
+			for (uint32_t j = 0; j < size; ++j)
+			{
+				data[j] = (unsigned char)j;
+			}
+
+			for (uint32_t newSize = size * 3; newSize <= subject.maxSize; newSize *= 3)
+			{
+				data = (unsigned char*)allocator.reallocate(data, size, newSize, align);
+				if ((uintptr_t)data % align != 0)
+				{
+					BenchmarkFn::fail("%s reallocated %u bytes aligned to %u at %p", subject.name, newSize, align, data);
+				}
+
+				for (uint32_t j = 0; j < size; ++j)
+				{
+					if (data[j] != (unsigned char)j)
+					{
+						BenchmarkFn::fail("%s lost byte %u reallocating %u bytes aligned to %u", subject.name, j, newSize, align);
+						break;
+					}
+				}
+
+				for (uint32_t j = size; j < newSize; ++j)
+				{
+					data[j] = (unsigned char)j;
+				}
+				size = newSize;
+			}
+
+			allocator.deallocate(data);
+		}
+	}
+
+	// Allocates every size at every alignment the subject supports, then checks that:
+	// - blocks are aligned
+	// - the size read back from the header of a block covers the request
+	// - blocks do not overlap, each one keeping the byte pattern written to it
+	static void checkSubject(const Subject& subject)
+	{
+		Allocator& allocator = *subject.allocator;
+
+		void* blockList[MAX_BLOCK_COUNT];
+		uint32_t sizeList[MAX_BLOCK_COUNT];
+		uint32_t blockCount = 0;
+
+		for (uint32_t i = 0; i < countof(ALIGN_LIST); ++i)
+		{
+			const uint32_t align = ALIGN_LIST[i];
+			if (align > subject.maxAlign)
+			{
+				continue;
+			}
+
+			for (uint32_t j = 0; j < countof(SIZE_LIST); ++j)
+			{
+				const uint32_t size = SIZE_LIST[j];
+				if (size > subject.maxSize)
+				{
+					continue;
+				}
+
+				void* data = allocator.allocate(size, align);
+				if (data == nullptr || (uintptr_t)data % align != 0)
+				{
+					BenchmarkFn::fail("%s returned %p for %u bytes aligned to %u", subject.name, data, size, align);
+					continue;
+				}
+
+				const uint32_t allocatedSize = allocator.getAllocatedSize(data);
+				if (allocatedSize != Allocator::SIZE_NOT_TRACKED && allocatedSize < size)
+				{
+					BenchmarkFn::fail("%s reports %u bytes for a block of %u bytes aligned to %u", subject.name, allocatedSize, size, align);
+				}
+
+				if (subject.hasMemoryHeader)
+				{
+					const char* header = (const char*)Memory::getHeader(data);
+					if (header + sizeof(Memory::Header) > (const char*)data || header + sizeof(Memory::Header) + align < (const char*)data)
+					{
+						BenchmarkFn::fail("%s finds the header of %p at %p for %u bytes aligned to %u", subject.name, data, header, size, align);
+					}
+				}
+
+				memset(data, int(blockCount + 1), size);
+				blockList[blockCount] = data;
+				sizeList[blockCount] = size;
+				++blockCount;
+			}
+		}
+
+		for (uint32_t i = 0; i < blockCount; ++i)
+		{
+			const unsigned char* bytes = (const unsigned char*)blockList[i];
+			for (uint32_t j = 0; j < sizeList[i]; ++j)
+			{
+				if (bytes[j] != (unsigned char)(i + 1))
+				{
+					BenchmarkFn::fail("%s block %p of %u bytes was overwritten at offset %u", subject.name, blockList[i], sizeList[i], j);
+					break;
+				}
+			}
+
+			if (subject.canDeallocate)
+			{
+				allocator.deallocate(blockList[i]);
+			}
+		}
+
+		if (subject.canDeallocate)
+		{
+			checkReallocate(subject);
+		}
+
+		fprintf(stderr, "alignment: %s checked %u blocks\n", subject.name, blockCount);
+	}
+
+} // namespace AlignmentCheckInternalFn
+
+// Checks that every allocator honors 16, 32, 64 and 128 byte alignments, finds its headers back and keeps both when reallocating
+// Failures are reported through BenchmarkFn::fail(), nothing is measured
+void runAlignmentCheck()
+{
+	using namespace AlignmentCheckInternalFn;
+
+	{
+		HeapAllocator heapAllocator;
+		Subject subject;
+		subject.name = "HeapAllocator";
+		subject.allocator = &heapAllocator;
+		subject.hasMemoryHeader = true;
+		checkSubject(subject);
+	}
+	{
+		ThreadCachingAllocator threadCachingAllocator;
+		Subject subject;
+		subject.name = "ThreadCachingAllocator";
+		subject.allocator = &threadCachingAllocator;
+		checkSubject(subject);
+	}
+	{
+		Subject subject;
+		subject.name = "ScratchAllocator";
+		subject.allocator = &getDefaultScratchAllocator();
+		checkSubject(subject);
+	}
+	{
+		LinearAllocator linearAllocator(getDefaultAllocator(), 1024 * 1024);
+		Subject subject;
+		subject.name = "LinearAllocator";
+		subject.allocator = &linearAllocator;
+		subject.maxSize = 70000;
+		subject.canDeallocate = false;
+		checkSubject(subject);
+		linearAllocator.clear();
+	}
+	{
+		VirtualArenaAllocator virtualArenaAllocator(64 * 1024 * 1024);
+		Subject subject;
+		subject.name = "VirtualArenaAllocator";
+		subject.allocator = &virtualArenaAllocator;
+		subject.canDeallocate = false;
+		checkSubject(subject);
+		virtualArenaAllocator.clear();
+	}
+	{
+		FrameAllocator frameAllocator(64 * 1024 * 1024);
+		Subject subject;
+		subject.name = "FrameAllocator";
+		subject.allocator = &frameAllocator;
+		subject.canDeallocate = false;
+		checkSubject(subject);
+	}
+	{
+		// The large requests do not fit in the arena and go to the backing allocator
+		FrameAllocator frameAllocator(64 * 1024);
+		Subject subject;
+		subject.name = "FrameAllocatorFallback";
+		subject.allocator = &frameAllocator;
+		subject.canDeallocate = false;
+		checkSubject(subject);
+
+		if (frameAllocator.fallbackCount == 0)
+		{
+			BenchmarkFn::fail("FrameAllocator did not fall back to its backing allocator");
+		}
+		frameAllocator.flip();
+		frameAllocator.flip();
+	}
+	for (uint32_t i = 0; i < countof(ALIGN_LIST); ++i)
+	{
+		// A pool serves a single block size and alignment, check one pool per alignment
+		PoolAllocator poolAllocator(getDefaultAllocator(), 5000, ALIGN_LIST[i]);
+		Subject subject;
+		subject.name = "PoolAllocator";
+		subject.allocator = &poolAllocator;
+		subject.maxSize = 5000;
+		subject.maxAlign = ALIGN_LIST[i];
+		checkSubject(subject);
+	}
+	{
+		HugePageAllocator hugePageAllocator(getDefaultAllocator());
+		Subject subject;
+		subject.name = "HugePageAllocator";
+		subject.allocator = &hugePageAllocator;
+		checkSubject(subject);
+	}
+	{
+		ProxyAllocator proxyAllocator(getDefaultAllocator(), "alignment");
+		Subject subject;
+		subject.name = "ProxyAllocator";
+		subject.allocator = &proxyAllocator;
+		checkSubject(subject);
+	}
+	{
+		TrackingAllocator trackingAllocator(getDefaultAllocator());
+		Subject subject;
+		subject.name = "TrackingAllocator";
+		subject.allocator = &trackingAllocator;
+		checkSubject(subject);
+	}
+	{
+		TempAllocator4096 tempAllocator;
+		Subject subject;
+		subject.name = "TempAllocator4096";
+		subject.allocator = &tempAllocator;
+		subject.canDeallocate = false;
+		checkSubject(subject);
+	}
+}
+
+} // namespace Rio
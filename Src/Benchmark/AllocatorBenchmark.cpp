@@ -0,0 +1,425 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Memory/HugePageAllocator.h"
+#include "Core/Memory/LinearAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/ProxyAllocator.h"
+#include "Core/Memory/TempAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+#include "Core/Memory/TrackingAllocator.h"
+#include "Core/Memory/VirtualArenaAllocator.h"
+#include "Core/Thread/Thread.h"
+
+namespace Rio
+{
+
+namespace AllocatorBenchmarkInternalFn
+{
+	const uint32_t MAX_THREADS = 8;
+	const uint32_t BATCH_SIZE = 64;
+	const uint32_t WORKING_SET_SIZE = 256;
+	const uint32_t ITERATION_COUNT = 4000;
+	const uint32_t MIN_ALLOCATION_SIZE = 16;
+	const uint32_t MAX_ALLOCATION_SIZE = 512;
+	const uint32_t MAX_MIXED_ALLOCATION_SIZE = 64 * 1024;
+
+	// Allocator under test, with what it is able to do
+	struct Subject
+	{
+		const char* name = nullptr;
+		Allocator* allocator = nullptr;
+		uint32_t maxThreadCount = 1; // Allocators which are not thread safe run on one thread only
+		bool canDeallocate = true;
+		uint32_t maxSize = MAX_MIXED_ALLOCATION_SIZE;
+
+		// Frees everything at once, for allocators which do not deallocate
+		void (*reset)(void* userData) = nullptr;
+		void* userData = nullptr;
+	};
+
+	struct Context;
+
+	struct Worker
+	{
+		Context* context = nullptr;
+		uint32_t index = 0;
+		uint64_t operationCount = 0;
+		LatencyHistogram* latencyHistogram = nullptr; // nullptr in the throughput pass
+		void* batch[WORKING_SET_SIZE];
+	};
+
+	struct Context
+	{
+		Subject* subject = nullptr;
+		uint32_t threadCount = 0;
+		uint32_t iterationCount = 0;
+		SpinBarrier startBarrier; // Workers and the timing thread
+		SpinBarrier stepBarrier; // Workers only
+		Worker workerList[MAX_THREADS];
+		LatencyHistogram latencyHistogramList[MAX_THREADS];
+
+		Context(Subject& subject, uint32_t threadCount, uint32_t iterationCount)
+			: subject(&subject)
+			, threadCount(threadCount)
+			, iterationCount(iterationCount)
+			, startBarrier(threadCount + 1)
+			, stepBarrier(threadCount)
+		{
+		}
+	};
+
+	inline uint32_t getRandomSize(uint32_t& state)
+	{
+		return MIN_ALLOCATION_SIZE + BenchmarkFn::getRandom(state) % (MAX_ALLOCATION_SIZE - MIN_ALLOCATION_SIZE);
+	}
+
+	// Mostly small blocks, some medium ones and a few big ones, like a game frame
+	inline uint32_t getMixedSize(uint32_t& state, uint32_t maxSize)
+	{
+		const uint32_t kind = BenchmarkFn::getRandom(state) % 100;
+		uint32_t size;
+		if (kind < 90)
+		{
+			size = 16 + BenchmarkFn::getRandom(state) % 240;
+		}
+		else if (kind < 99)
+		{
+			size = 256 + BenchmarkFn::getRandom(state) % 3840;
+		}
+		else
+		{
+			size = 4096 + BenchmarkFn::getRandom(state) % (MAX_MIXED_ALLOCATION_SIZE - 4096);
+		}
+		return size < maxSize ? size : maxSize;
+	}
+
+	inline void* allocate(Worker& worker, uint32_t size)
+	{
+		Allocator& allocator = *(worker.context->subject->allocator);
+		if (worker.latencyHistogram == nullptr)
+		{
+			return allocator.allocate(size);
+		}
+
+		const int64_t start = BenchmarkFn::getTimeNs();
+		void* p = allocator.allocate(size);
+		worker.latencyHistogram->record(BenchmarkFn::getTimeNs() - start);
+		return p;
+	}
+
+	inline void deallocate(Worker& worker, void* p)
+	{
+		Allocator& allocator = *(worker.context->subject->allocator);
+		if (worker.latencyHistogram == nullptr)
+		{
+			allocator.deallocate(p);
+			return;
+		}
+
+		const int64_t start = BenchmarkFn::getTimeNs();
+		allocator.deallocate(p);
+		worker.latencyHistogram->record(BenchmarkFn::getTimeNs() - start);
+	}
+
+	// Frees blocks [0, <count>) of the batch in reverse order, or all at once if the allocator does not deallocate
+	inline void releaseBatch(Worker& worker, uint32_t count)
+	{
+		Subject& subject = *(worker.context->subject);
+		if (!subject.canDeallocate)
+		{
+			subject.reset(subject.userData);
+			return;
+		}
+
+		for (uint32_t j = count; j > 0; --j)
+		{
+			deallocate(worker, worker.batch[j - 1]);
+		}
+		worker.operationCount += count;
+	}
+
+	// Every block is freed right after being allocated
+	static int32_t pairs(void* data)
+	{
+		Worker& worker = *(Worker*)data;
+		const uint32_t maxSize = worker.context->subject->maxSize;
+		uint32_t state = 0x9e3779b9u + worker.index;
+
+		worker.context->startBarrier.wait();
+
+		for (uint32_t i = 0; i < worker.context->iterationCount * BATCH_SIZE; ++i)
+		{
+			const uint32_t size = getRandomSize(state);
+			worker.batch[0] = allocate(worker, size < maxSize ? size : maxSize);
+			releaseBatch(worker, 1);
+		}
+		worker.operationCount += uint64_t(worker.context->iterationCount) * BATCH_SIZE;
+		return 0;
+	}
+
+	// A burst of blocks is allocated and then freed in reverse order, like a stack of temporaries
+	static int32_t lifoBurst(void* data)
+	{
+		Worker& worker = *(Worker*)data;
+		const uint32_t maxSize = worker.context->subject->maxSize;
+		uint32_t state = 0x9e3779b9u + worker.index;
+
+		worker.context->startBarrier.wait();
+
+		for (uint32_t i = 0; i < worker.context->iterationCount; ++i)
+		{
+			for (uint32_t j = 0; j < BATCH_SIZE; ++j)
+			{
+				const uint32_t size = getRandomSize(state);
+				worker.batch[j] = allocate(worker, size < maxSize ? size : maxSize);
+			}
+			worker.operationCount += BATCH_SIZE;
+			releaseBatch(worker, BATCH_SIZE);
+		}
+		return 0;
+	}
+
+	// A working set of mixed size blocks where a random block is replaced at each step
+	// Only for allocators which deallocate
+	static int32_t mixedSizes(void* data)
+	{
+		Worker& worker = *(Worker*)data;
+		const uint32_t maxSize = worker.context->subject->maxSize;
+		uint32_t state = 0x9e3779b9u + worker.index;
+
+		for (uint32_t j = 0; j < WORKING_SET_SIZE; ++j)
+		{
+			worker.batch[j] = worker.context->subject->allocator->allocate(getMixedSize(state, maxSize));
+		}
+
+		worker.context->startBarrier.wait();
+
+		for (uint32_t i = 0; i < worker.context->iterationCount * BATCH_SIZE; ++i)
+		{
+			const uint32_t slot = BenchmarkFn::getRandom(state) % WORKING_SET_SIZE;
+			deallocate(worker, worker.batch[slot]);
+			worker.batch[slot] = allocate(worker, getMixedSize(state, maxSize));
+		}
+		worker.operationCount += uint64_t(worker.context->iterationCount) * BATCH_SIZE * 2;
+
+		for (uint32_t j = 0; j < WORKING_SET_SIZE; ++j)
+		{
+			worker.context->subject->allocator->deallocate(worker.batch[j]);
+		}
+		return 0;
+	}
+
+	// Every thread allocates a batch and frees the batch allocated by its neighbour
+	// Only for thread safe allocators which deallocate
+	static int32_t crossThreadFree(void* data)
+	{
+		Worker& worker = *(Worker*)data;
+		Context& context = *(worker.context);
+		Worker& neighbour = context.workerList[(worker.index + 1) % context.threadCount];
+		uint32_t state = 0x9e3779b9u + worker.index;
+
+		context.startBarrier.wait();
+
+		for (uint32_t i = 0; i < context.iterationCount; ++i)
+		{
+			for (uint32_t j = 0; j < BATCH_SIZE; ++j)
+			{
+				worker.batch[j] = allocate(worker, getRandomSize(state));
+			}
+
+			context.stepBarrier.wait();
+
+			for (uint32_t j = 0; j < BATCH_SIZE; ++j)
+			{
+				deallocate(worker, neighbour.batch[j]);
+			}
+
+			context.stepBarrier.wait();
+		}
+		worker.operationCount += uint64_t(context.iterationCount) * BATCH_SIZE * 2;
+		return 0;
+	}
+
+	// Runs <function> on <threadCount> threads, returns the elapsed time
+	static int64_t runPass(Context& context, Thread::ThreadFunction function, bool measureLatency)
+	{
+		Thread threadList[MAX_THREADS];
+
+		for (uint32_t i = 0; i < context.threadCount; ++i)
+		{
+			Worker& worker = context.workerList[i];
+			worker.context = &context;
+			worker.index = i;
+			worker.operationCount = 0;
+			worker.latencyHistogram = measureLatency ? &context.latencyHistogramList[i] : nullptr;
+			threadList[i].start(function, &worker);
+		}
+
+		context.startBarrier.wait();
+		const int64_t start = BenchmarkFn::getTimeNs();
+
+		for (uint32_t i = 0; i < context.threadCount; ++i)
+		{
+			threadList[i].stop();
+		}
+
+		return BenchmarkFn::getTimeNs() - start;
+	}
+
+	// Measures throughput in a first pass and the latency of single operations in a second one
+	static void run(const char* benchmark, Thread::ThreadFunction function, uint32_t iterationCount, Subject& subject, uint32_t threadCount)
+	{
+		Context context(subject, threadCount, iterationCount);
+
+		const int64_t elapsed = runPass(context, function, false);
+		uint64_t operationCount = 0;
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			operationCount += context.workerList[i].operationCount;
+		}
+
+		runPass(context, function, true);
+		LatencyHistogram latencyHistogram;
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			latencyHistogram.merge(context.latencyHistogramList[i]);
+		}
+
+		BenchmarkFn::report(benchmark, subject.name, threadCount, operationCount, elapsed, &latencyHistogram);
+	}
+
+	static void runSubject(Subject& subject)
+	{
+		const uint32_t threadCountList[] = { 1, 2, 4, 8 };
+		for (uint32_t i = 0; i < countof(threadCountList) && threadCountList[i] <= subject.maxThreadCount; ++i)
+		{
+			const uint32_t threadCount = threadCountList[i];
+			run("allocatorPairs", pairs, ITERATION_COUNT, subject, threadCount);
+			run("allocatorLifoBurst", lifoBurst, ITERATION_COUNT, subject, threadCount);
+
+			if (subject.canDeallocate)
+			{
+				run("allocatorMixedSizes", mixedSizes, ITERATION_COUNT, subject, threadCount);
+			}
+
+			if (subject.canDeallocate && threadCount > 1)
+			{
+				run("allocatorCrossThreadFree", crossThreadFree, ITERATION_COUNT / 4, subject, threadCount);
+			}
+		}
+	}
+
+	static void resetLinear(void* userData)
+	{
+		((LinearAllocator*)userData)->clear();
+	}
+
+	static void resetVirtualArena(void* userData)
+	{
+		((VirtualArenaAllocator*)userData)->clear();
+	}
+
+	static void resetTemp(void* userData)
+	{
+		// Destroying the temp allocator is the only way to free its memory
+		TempAllocator4096* tempAllocator = (TempAllocator4096*)userData;
+		tempAllocator->~TempAllocator4096();
+		new (tempAllocator) TempAllocator4096();
+	}
+
+} // namespace AllocatorBenchmarkInternalFn
+
+// Measures every allocator under alloc/free pairs, LIFO bursts, a mixed size working set and cross-thread frees
+void runAllocatorBenchmark()
+{
+	using namespace AllocatorBenchmarkInternalFn;
+
+	{
+		HeapAllocator heapAllocator;
+		Subject subject;
+		subject.name = "HeapAllocator";
+		subject.allocator = &heapAllocator;
+		subject.maxThreadCount = MAX_THREADS;
+		runSubject(subject);
+	}
+	{
+		ThreadCachingAllocator threadCachingAllocator;
+		Subject subject;
+		subject.name = "ThreadCachingAllocator";
+		subject.allocator = &threadCachingAllocator;
+		subject.maxThreadCount = MAX_THREADS;
+		runSubject(subject);
+	}
+	{
+		Subject subject;
+		subject.name = "ScratchAllocator";
+		subject.allocator = &getDefaultScratchAllocator();
+		subject.maxThreadCount = MAX_THREADS;
+		runSubject(subject);
+	}
+	{
+		ProxyAllocator proxyAllocator(getDefaultAllocator(), "benchmark");
+		Subject subject;
+		subject.name = "ProxyAllocator";
+		subject.allocator = &proxyAllocator;
+		subject.maxThreadCount = MAX_THREADS;
+		runSubject(subject);
+	}
+	{
+		PoolAllocator poolAllocator(getDefaultAllocator(), MAX_ALLOCATION_SIZE, Allocator::DEFAULT_ALIGN, 256, true);
+		Subject subject;
+		subject.name = "PoolAllocator";
+		subject.allocator = &poolAllocator;
+		subject.maxThreadCount = MAX_THREADS;
+		subject.maxSize = MAX_ALLOCATION_SIZE;
+		runSubject(subject);
+	}
+	{
+		HugePageAllocator hugePageAllocator(getDefaultAllocator());
+		Subject subject;
+		subject.name = "HugePageAllocator";
+		subject.allocator = &hugePageAllocator;
+		runSubject(subject);
+	}
+	{
+		TrackingAllocator trackingAllocator(getDefaultAllocator());
+		Subject subject;
+		subject.name = "TrackingAllocator";
+		subject.allocator = &trackingAllocator;
+		// A stack walk per allocation dominates, one thread is enough to see its cost
+		runSubject(subject);
+	}
+	{
+		LinearAllocator linearAllocator(getDefaultAllocator(), BATCH_SIZE * MAX_ALLOCATION_SIZE * 2);
+		Subject subject;
+		subject.name = "LinearAllocator";
+		subject.allocator = &linearAllocator;
+		subject.canDeallocate = false;
+		subject.reset = resetLinear;
+		subject.userData = &linearAllocator;
+		runSubject(subject);
+	}
+	{
+		VirtualArenaAllocator virtualArenaAllocator(BATCH_SIZE * MAX_ALLOCATION_SIZE * 2);
+		Subject subject;
+		subject.name = "VirtualArenaAllocator";
+		subject.allocator = &virtualArenaAllocator;
+		subject.canDeallocate = false;
+		subject.reset = resetVirtualArena;
+		subject.userData = &virtualArenaAllocator;
+		runSubject(subject);
+	}
+	{
+		TempAllocator4096 tempAllocator;
+		Subject subject;
+		subject.name = "TempAllocator4096";
+		subject.allocator = &tempAllocator;
+		subject.canDeallocate = false;
+		subject.reset = resetTemp;
+		subject.userData = &tempAllocator;
+		runSubject(subject);
+	}
+}
+
+} // namespace Rio
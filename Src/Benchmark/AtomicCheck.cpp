@@ -0,0 +1,229 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/AtomicInt.h"
+#include "Core/Thread/Thread.h"
+
+#include <stdio.h> // fprintf
+
+namespace Rio
+{
+
+namespace AtomicCheckInternalFn
+{
+	const uint32_t THREAD_COUNT = 4;
+	const uint32_t ITERATION_COUNT = 100000;
+	const uint32_t NODES_PER_THREAD = 1000;
+	const uint32_t MESSAGE_COUNT = 10000;
+	const uint64_t COUNTER_64_STEP = 0x100000001ull; // Carries into the high half, so torn 64-bit updates show up
+
+	struct Node
+	{
+		Node* next = nullptr;
+		uint32_t threadIndex = 0;
+	};
+
+	struct Context
+	{
+		SpinBarrier startBarrier;
+		Atomic<uint64_t> counter64;
+		Atomic<int32_t> compareExchangeCounter;
+		AtomicInt atomicIntCounter;
+		Atomic<Node*> stackHead;
+		Node nodeList[THREAD_COUNT][NODES_PER_THREAD];
+
+		// Messages passed from one thread to another, <payload> is only ordered by the release and acquire on the sequence numbers
+		uint32_t payload[4];
+		Atomic<uint32_t> sentCount;
+		Atomic<uint32_t> receivedCount;
+		uint32_t messageErrorCount = 0;
+
+		Context()
+			: startBarrier(THREAD_COUNT + 2)
+			, atomicIntCounter(0)
+		{
+		}
+	};
+
+	struct Worker
+	{
+		Context* context = nullptr;
+		uint32_t index = 0;
+	};
+
+	static int32_t runCounters(void* userData)
+	{
+		Worker& worker = *(Worker*)userData;
+		Context& context = *(worker.context);
+		context.startBarrier.wait();
+
+		for (uint32_t i = 0; i < ITERATION_COUNT; ++i)
+		{
+			context.counter64.fetchAdd(COUNTER_64_STEP, MemoryOrder::RELAXED);
+
+			int32_t expected = context.compareExchangeCounter.load(MemoryOrder::RELAXED);
+			while (!context.compareExchangeCounter.compareExchange(expected, expected + 1, MemoryOrder::ACQ_REL))
+			{
+			}
+
+			context.atomicIntCounter.fetchAdd(1);
+		}
+
+		// Lock-free stack push, the nodes are read back by the main thread once all workers are stopped
+		for (uint32_t i = 0; i < NODES_PER_THREAD; ++i)
+		{
+			Node* node = &context.nodeList[worker.index][i];
+			node->threadIndex = worker.index;
+
+			Node* head = context.stackHead.load(MemoryOrder::RELAXED);
+			do
+			{
+				node->next = head;
+			}
+			while (!context.stackHead.compareExchange(head, node, MemoryOrder::RELEASE));
+		}
+
+		return 0;
+	}
+
+	static int32_t runSender(void* userData)
+	{
+		Context& context = *(Context*)userData;
+		context.startBarrier.wait();
+
+		for (uint32_t i = 1; i <= MESSAGE_COUNT; ++i)
+		{
+			while (context.receivedCount.load(MemoryOrder::ACQUIRE) != i - 1)
+			{
+				BenchmarkFn::yield();
+			}
+
+			for (uint32_t j = 0; j < countof(context.payload); ++j)
+			{
+				context.payload[j] = i + j;
+			}
+			context.sentCount.store(i, MemoryOrder::RELEASE);
+		}
+
+		return 0;
+	}
+
+	static int32_t runReceiver(void* userData)
+	{
+		Context& context = *(Context*)userData;
+		context.startBarrier.wait();
+
+		for (uint32_t i = 1; i <= MESSAGE_COUNT; ++i)
+		{
+			while (context.sentCount.load(MemoryOrder::ACQUIRE) != i)
+			{
+				BenchmarkFn::yield();
+			}
+
+			for (uint32_t j = 0; j < countof(context.payload); ++j)
+			{
+				context.messageErrorCount += context.payload[j] != i + j ? 1 : 0;
+			}
+			context.receivedCount.store(i, MemoryOrder::RELEASE);
+		}
+
+		return 0;
+	}
+
+	// Single threaded checks of the free functions on plain integers
+	static void checkFreeFunctions()
+	{
+		uint32_t value32 = 5;
+		if (AtomicFn::fetchSub(&value32, 7) != 5 || value32 != 0xfffffffeu)
+		{
+			BenchmarkFn::fail("atomic fetchSub on uint32_t does not wrap around, value is %u", value32);
+		}
+
+		int64_t value64 = 0;
+		AtomicFn::store(&value64, -3, MemoryOrder::SEQ_CST);
+		if (AtomicFn::exchange(&value64, (int64_t)1) != -3 || AtomicFn::load(&value64) != 1)
+		{
+			BenchmarkFn::fail("atomic exchange on int64_t returned the wrong value");
+		}
+
+		int64_t expected = 0;
+		if (AtomicFn::compareExchange(&value64, expected, (int64_t)2) || expected != 1)
+		{
+			BenchmarkFn::fail("failed atomic compareExchange on int64_t did not return the current value");
+		}
+	}
+
+} // namespace AtomicCheckInternalFn
+
+// Stresses Atomic<T>, AtomicInt and AtomicFn from several threads and checks the results
+// Built with AMSTEL_SANITIZE_THREAD it also lets ThreadSanitizer check the memory orders
+// Failures are reported through BenchmarkFn::fail(), nothing is measured
+void runAtomicCheck()
+{
+	using namespace AtomicCheckInternalFn;
+
+	checkFreeFunctions();
+
+	Context* context = RIO_NEW(getDefaultAllocator(), Context)();
+
+	Worker workerList[THREAD_COUNT];
+	Thread threadList[THREAD_COUNT];
+	for (uint32_t i = 0; i < THREAD_COUNT; ++i)
+	{
+		workerList[i].context = context;
+		workerList[i].index = i;
+		threadList[i].start(runCounters, &workerList[i]);
+	}
+
+	Thread senderThread;
+	Thread receiverThread;
+	senderThread.start(runSender, context);
+	receiverThread.start(runReceiver, context);
+
+	for (uint32_t i = 0; i < THREAD_COUNT; ++i)
+	{
+		threadList[i].stop();
+	}
+	senderThread.stop();
+	receiverThread.stop();
+
+	const uint64_t expected64 = (uint64_t)THREAD_COUNT * ITERATION_COUNT * COUNTER_64_STEP;
+	if (context->counter64.load() != expected64)
+	{
+		BenchmarkFn::fail("atomic 64-bit fetchAdd counted %llx instead of %llx", (unsigned long long)context->counter64.load(), (unsigned long long)expected64);
+	}
+
+	const int32_t expectedCount = int32_t(THREAD_COUNT * ITERATION_COUNT);
+	if (context->compareExchangeCounter.load() != expectedCount)
+	{
+		BenchmarkFn::fail("atomic compareExchange counted %d instead of %d", context->compareExchangeCounter.load(), expectedCount);
+	}
+	if (context->atomicIntCounter.load() != expectedCount)
+	{
+		BenchmarkFn::fail("AtomicInt counted %d instead of %d", context->atomicIntCounter.load(), expectedCount);
+	}
+
+	uint32_t nodeCountList[THREAD_COUNT] = {};
+	for (Node* node = context->stackHead.load(MemoryOrder::ACQUIRE); node != nullptr; node = node->next)
+	{
+		++nodeCountList[node->threadIndex];
+	}
+	for (uint32_t i = 0; i < THREAD_COUNT; ++i)
+	{
+		if (nodeCountList[i] != NODES_PER_THREAD)
+		{
+			BenchmarkFn::fail("atomic pointer stack holds %u nodes of thread %u instead of %u", nodeCountList[i], i, NODES_PER_THREAD);
+		}
+	}
+
+	if (context->messageErrorCount != 0)
+	{
+		BenchmarkFn::fail("%u release/acquire messages were received with a stale payload", context->messageErrorCount);
+	}
+
+	fprintf(stderr, "atomic: %u threads checked\n", THREAD_COUNT + 2);
+
+	RIO_DELETE(getDefaultAllocator(), context);
+}
+
+} // namespace Rio
@@ -0,0 +1,259 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Os.h"
+#include "Core/Platform.h"
+#include "Core/Thread/Atomic.h"
+
+#include <stdarg.h> // va_list
+#include <stdio.h> // printf, vfprintf
+#include <stdlib.h> // EXIT_FAILURE
+#include <string.h> // memset, strcmp
+
+#if RIO_PLATFORM_POSIX
+	#include <sched.h> // sched_yield
+#elif RIO_PLATFORM_WINDOWS
+	#include <windows.h>
+#endif
+
+namespace Rio
+{
+
+namespace BenchmarkInternalFn
+{
+	static uint32_t failureCount = 0;
+
+} // namespace BenchmarkInternalFn
+
+namespace BenchmarkFn
+{
+	int64_t getTimeNs()
+	{
+		const int64_t time = OsFn::getClockTime();
+		const int64_t frequency = OsFn::getClockFrequency();
+		return (time / frequency) * 1000000000 + (time % frequency) * 1000000000 / frequency;
+	}
+
+	void yield()
+	{
+#if RIO_PLATFORM_POSIX
+		sched_yield();
+#elif RIO_PLATFORM_WINDOWS
+		SwitchToThread();
+#endif
+	}
+
+	void printHeader()
+	{
+		printf("benchmark,subject,threads,operations,elapsedNs,nsPerOperation,operationsPerSecond,p50Ns,p99Ns,p999Ns,maxNs\n");
+	}
+
+	void report(const char* benchmark, const char* subject, uint32_t threads, uint64_t operations, int64_t elapsedNs, const LatencyHistogram* latencyHistogram)
+	{
+		const double nsPerOperation = operations ? double(elapsedNs) / double(operations) : 0.0;
+		const double operationsPerSecond = elapsedNs ? double(operations) * 1e9 / double(elapsedNs) : 0.0;
+		printf("%s,%s,%u,%llu,%lld,%.2f,%.0f"
+			, benchmark
+			, subject
+			, threads
+			, (unsigned long long)operations
+			, (long long)elapsedNs
+			, nsPerOperation
+			, operationsPerSecond
+			);
+
+		if (latencyHistogram != nullptr)
+		{
+			printf(",%lld,%lld,%lld,%lld\n"
+				, (long long)latencyHistogram->getPercentile(50.0)
+				, (long long)latencyHistogram->getPercentile(99.0)
+				, (long long)latencyHistogram->getPercentile(99.9)
+				, (long long)latencyHistogram->maxNs
+				);
+		}
+		else
+		{
+			printf(",,,,\n");
+		}
+		fflush(stdout);
+	}
+
+	void fail(const char* format, ...)
+	{
+		va_list argumentList;
+		va_start(argumentList, format);
+		fprintf(stderr, "FAILED: ");
+		vfprintf(stderr, format, argumentList);
+		fprintf(stderr, "\n");
+		va_end(argumentList);
+
+		AtomicFn::fetchAdd(&BenchmarkInternalFn::failureCount, 1);
+	}
+
+	uint32_t getFailureCount()
+	{
+		return AtomicFn::load(&BenchmarkInternalFn::failureCount);
+	}
+
+} // namespace BenchmarkFn
+
+namespace BenchmarkInternalFn
+{
+	inline uint32_t getHighestBit(uint64_t value)
+	{
+		uint32_t bit = 0;
+		while (value >>= 1)
+		{
+			++bit;
+		}
+		return bit;
+	}
+
+	inline uint32_t getBucketIndex(uint64_t ns)
+	{
+		if (ns < LatencyHistogram::SUB_BUCKET_COUNT)
+		{
+			return (uint32_t)ns;
+		}
+
+		// The highest bit selects the power of two, the next SUB_BUCKET_BITS bits the step inside it
+		const uint32_t highestBit = getHighestBit(ns);
+		const uint32_t subBucket = (uint32_t)(ns >> (highestBit - LatencyHistogram::SUB_BUCKET_BITS)) & (LatencyHistogram::SUB_BUCKET_COUNT - 1);
+		return (highestBit - LatencyHistogram::SUB_BUCKET_BITS + 1) * LatencyHistogram::SUB_BUCKET_COUNT + subBucket;
+	}
+
+	// Returns the highest latency which falls in bucket <index>
+	inline int64_t getBucketUpperBound(uint32_t index)
+	{
+		if (index < LatencyHistogram::SUB_BUCKET_COUNT)
+		{
+			return index;
+		}
+
+		const uint32_t shift = index / LatencyHistogram::SUB_BUCKET_COUNT - 1;
+		const uint64_t subBucket = index % LatencyHistogram::SUB_BUCKET_COUNT;
+		return (int64_t)(((LatencyHistogram::SUB_BUCKET_COUNT + subBucket + 1) << shift) - 1);
+	}
+
+} // namespace BenchmarkInternalFn
+
+LatencyHistogram::LatencyHistogram()
+{
+	memset(this->countList, 0, sizeof(this->countList));
+}
+
+void LatencyHistogram::record(int64_t ns)
+{
+	ns = ns < 0 ? 0 : ns;
+	++(this->countList[BenchmarkInternalFn::getBucketIndex((uint64_t)ns)]);
+	++(this->totalCount);
+	this->maxNs = ns > this->maxNs ? ns : this->maxNs;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+	for (uint32_t i = 0; i < BUCKET_COUNT; ++i)
+	{
+		this->countList[i] += other.countList[i];
+	}
+	this->totalCount += other.totalCount;
+	this->maxNs = other.maxNs > this->maxNs ? other.maxNs : this->maxNs;
+}
+
+int64_t LatencyHistogram::getPercentile(double percentile) const
+{
+	const uint64_t rank = (uint64_t)(double(this->totalCount) * percentile / 100.0);
+
+	uint64_t count = 0;
+	for (uint32_t i = 0; i < BUCKET_COUNT; ++i)
+	{
+		count += this->countList[i];
+		if (count > rank)
+		{
+			const int64_t upperBound = BenchmarkInternalFn::getBucketUpperBound(i);
+			return upperBound < this->maxNs ? upperBound : this->maxNs;
+		}
+	}
+	return this->maxNs;
+}
+
+SpinBarrier::SpinBarrier(uint32_t count)
+	: count(count)
+{
+}
+
+void SpinBarrier::wait()
+{
+	const uint32_t currentGeneration = AtomicFn::loadAcquire(&(this->generation));
+	if (AtomicFn::fetchAdd(&(this->arrived), 1, MemoryOrder::ACQ_REL) + 1 == this->count)
+	{
+		AtomicFn::storeRelaxed(&(this->arrived), 0);
+		AtomicFn::storeRelease(&(this->generation), currentGeneration + 1);
+		return;
+	}
+
+	// Yield so that the barrier still makes progress when there are more threads than cores
+	while (AtomicFn::loadAcquire(&(this->generation)) == currentGeneration)
+	{
+		BenchmarkFn::yield();
+	}
+}
+
+} // namespace Rio
+
+struct InitMemoryGlobals
+{
+	InitMemoryGlobals()
+	{
+		Rio::MemoryGlobalFn::init();
+	}
+
+	~InitMemoryGlobals()
+	{
+		Rio::MemoryGlobalFn::shutdown();
+	}
+};
+
+// Runs every suite, or only the ones named on the command line
+// Exits with a failure status if any check failed
+int main(int argumentsCount, char** argumentList)
+{
+	using namespace Rio;
+
+	InitMemoryGlobals initMemoryGlobals;
+	RIO_UNUSED(initMemoryGlobals);
+
+	BenchmarkFn::printHeader();
+
+	struct
+	{
+		const char* name;
+		void (*run)();
+	} suiteList[] =
+	{
+		{ "alignment", runAlignmentCheck },
+		{ "allocator", runAllocatorBenchmark },
+		{ "atomic", runAtomicCheck },
+		{ "container", runContainerBenchmark },
+		{ "hashmap", runHashMapBenchmark },
+		{ "jobs", runJobBenchmark },
+		{ "json", runJsonBenchmark },
+		{ "queue", runQueueBenchmark },
+		{ "resource", runResourceTableBenchmark },
+	};
+
+	for (uint32_t i = 0; i < countof(suiteList); ++i)
+	{
+		bool isSelected = argumentsCount < 2;
+		for (int j = 1; j < argumentsCount; ++j)
+		{
+			isSelected = isSelected || strcmp(argumentList[j], suiteList[i].name) == 0;
+		}
+
+		if (isSelected)
+		{
+			suiteList[i].run();
+		}
+	}
+
+	return BenchmarkFn::getFailureCount() == 0 ? 0 : EXIT_FAILURE;
+}
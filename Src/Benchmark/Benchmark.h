@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace Rio
+{
+
+// Distribution of operation latencies
+// Buckets split each power of two of nanoseconds in SUB_BUCKET_COUNT steps, so percentiles are within 25%
+struct LatencyHistogram
+{
+	static const uint32_t SUB_BUCKET_BITS = 2;
+	static const uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+	static const uint32_t BUCKET_COUNT = 64 * SUB_BUCKET_COUNT;
+
+	uint64_t countList[BUCKET_COUNT];
+	uint64_t totalCount = 0;
+	int64_t maxNs = 0;
+
+	LatencyHistogram();
+
+	// Records an operation which took <ns> nanoseconds
+	void record(int64_t ns);
+
+	// Adds the operations recorded by <other>
+	void merge(const LatencyHistogram& other);
+
+	// Returns the latency in nanoseconds below which <percentile> percent of the operations fall
+	int64_t getPercentile(double percentile) const;
+};
+
+// Helpers shared by the benchmarks
+// Results are printed to stdout one per line as comma separated values:
+// benchmark,subject,threads,operations,elapsedNs,nsPerOperation,operationsPerSecond,p50Ns,p99Ns,p999Ns,maxNs
+// Latency columns are empty when the benchmark does not measure single operations
+// Latencies are measured in a separate pass and include the cost of reading the clock
+namespace BenchmarkFn
+{
+	// Returns a monotonic time stamp in nanoseconds
+	int64_t getTimeNs();
+
+	// Gives the rest of the time slice of the calling thread to other threads
+	void yield();
+
+	// Prints the header line of the results
+	void printHeader();
+
+	// Prints the result of <operations> done by <threads> threads on <subject> in <elapsedNs> nanoseconds
+	// <latencyHistogram> may be nullptr
+	void report(const char* benchmark, const char* subject, uint32_t threads, uint64_t operations, int64_t elapsedNs, const LatencyHistogram* latencyHistogram = nullptr);
+
+	// Reports a failed check on stderr, the program then exits with a failure status once all the suites have run
+	// Used by the suites which verify results instead of measuring them
+	void fail(const char* format, ...);
+
+	// Returns the number of failed checks reported so far
+	uint32_t getFailureCount();
+
+	// Returns the next value of the xorshift generator <state>
+	inline uint32_t getRandom(uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+} // namespace BenchmarkFn
+
+// Lets <count> threads wait for each other before starting a measured phase
+struct SpinBarrier
+{
+	uint32_t count = 0;
+	uint32_t arrived = 0;
+	uint32_t generation = 0;
+
+	SpinBarrier(uint32_t count);
+
+	void wait();
+};
+
+// Suites
+void runAlignmentCheck();
+void runAllocatorBenchmark();
+void runAtomicCheck();
+void runContainerBenchmark();
+void runHashMapBenchmark();
+void runJobBenchmark();
+void runJsonBenchmark();
+void runQueueBenchmark();
+void runResourceTableBenchmark();
+
+} // namespace Rio
@@ -0,0 +1,109 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Vector.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Strings/DynamicString.h"
+
+#include <stdio.h> // snprintf
+
+namespace Rio
+{
+
+// Containers filled one item at a time from empty, so most of the cost is in growing them
+// File name lists are the Vector<DynamicString> the data compiler builds while scanning the source directory
+namespace ContainerBenchmarkInternalFn
+{
+	const uint32_t ROUND_COUNT = 20;
+	const uint32_t STRING_COUNT = 20000;
+	const uint32_t ITEM_COUNT = 1 << 20;
+
+	// Keeps the compiler from optimizing the containers away
+	volatile uint64_t sink = 0;
+
+	// DynamicString without the TRIVIALLY_RELOCATABLE marker, relocated by copying every string like Vector used to
+	struct CopiedString
+	{
+		ALLOCATOR_AWARE;
+
+		DynamicString dynamicString;
+
+		CopiedString(Allocator& a)
+			: dynamicString(a)
+		{
+		}
+
+		// DynamicString has no copy constructor, copy it the way Vector copies allocator aware items
+		CopiedString(const CopiedString& other)
+			: dynamicString(*(other.dynamicString.dataArray.allocator))
+		{
+			this->dynamicString = other.dynamicString;
+		}
+
+		CopiedString& operator=(const CopiedString& other) = default;
+	};
+
+	inline DynamicString& getString(DynamicString& item)
+	{
+		return item;
+	}
+
+	inline DynamicString& getString(CopiedString& item)
+	{
+		return item.dynamicString;
+	}
+
+	template <typename T>
+	void runFileNameList(const char* subject)
+	{
+		uint64_t checksum = 0;
+
+		const int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+		{
+			Vector<T> fileNameList(getDefaultAllocator());
+			T item(getDefaultAllocator());
+			for (uint32_t i = 0; i < STRING_COUNT; ++i)
+			{
+				char fileName[64];
+				snprintf(fileName, sizeof(fileName), "units/level/props/prop_%u.unit", i);
+				getString(item) = fileName;
+				VectorFn::pushBack(fileNameList, item);
+			}
+			checksum += getString(fileNameList[STRING_COUNT - 1]).getLength();
+		}
+		BenchmarkFn::report("vectorPushBack", subject, 1, uint64_t(ROUND_COUNT) * STRING_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		sink = checksum;
+	}
+
+	void runArray()
+	{
+		uint64_t checksum = 0;
+
+		const int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+		{
+			Array<uint32_t> itemList(getDefaultAllocator());
+			for (uint32_t i = 0; i < ITEM_COUNT; ++i)
+			{
+				ArrayFn::pushBack(itemList, i);
+			}
+			checksum += itemList[ITEM_COUNT - 1];
+		}
+		BenchmarkFn::report("arrayPushBack", "uint32_t", 1, uint64_t(ROUND_COUNT) * ITEM_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		sink = checksum;
+	}
+
+} // namespace ContainerBenchmarkInternalFn
+
+void runContainerBenchmark()
+{
+	using namespace ContainerBenchmarkInternalFn;
+
+	runFileNameList<CopiedString>("Vector<CopiedString>");
+	runFileNameList<DynamicString>("Vector<DynamicString>");
+	runArray();
+}
+
+} // namespace Rio
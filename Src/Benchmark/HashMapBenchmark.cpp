@@ -0,0 +1,122 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Containers/FlatHashMap.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Murmur.h"
+
+#include <stdio.h> // snprintf
+
+namespace Rio
+{
+
+namespace HashMapBenchmarkInternalFn
+{
+	const uint32_t LOOKUP_COUNT = 1 << 22;
+	const uint32_t CHURN_COUNT = 1 << 20;
+	const uint32_t BATCH_SIZE = 64;
+
+	// Keeps the compiler from optimizing the lookups away
+	volatile uint32_t sink = 0;
+
+	// Unit indices are sequential, string ids are spread over the whole range
+	struct KeyKind
+	{
+		enum Enum
+		{
+			SEQUENTIAL,
+			HASHED
+		};
+	};
+
+	inline uint32_t getKey(uint32_t i, KeyKind::Enum keyKind)
+	{
+		return keyKind == KeyKind::SEQUENTIAL ? i : murmur32(&i, sizeof(i), 0);
+	}
+
+	template <typename TMap>
+	void runMap(const char* mapName, uint32_t count, KeyKind::Enum keyKind)
+	{
+		char subject[64];
+		snprintf(subject, sizeof(subject), "%s/%s/%u", mapName, keyKind == KeyKind::SEQUENTIAL ? "sequential" : "hashed", count);
+
+		TMap map(getDefaultAllocator());
+
+		int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			HashMapFn::set(map, getKey(i, keyKind), i);
+		}
+		BenchmarkFn::report("hashMapInsert", subject, 1, count, BenchmarkFn::getTimeNs() - start);
+
+		// Random order, so every lookup is a cache miss on big maps
+		uint32_t state = 0x9e3779b9u;
+		uint32_t checksum = 0;
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < LOOKUP_COUNT; ++i)
+		{
+			checksum += HashMapFn::get(map, getKey(BenchmarkFn::getRandom(state) % count, keyKind), UINT32_MAX);
+		}
+		BenchmarkFn::report("hashMapFindHit", subject, 1, LOOKUP_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		// Same lookups through getBatch(), like the transform propagation to the renderer
+		uint32_t keyList[BATCH_SIZE];
+		uint32_t valueList[BATCH_SIZE];
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < LOOKUP_COUNT; i += BATCH_SIZE)
+		{
+			for (uint32_t j = 0; j < BATCH_SIZE; ++j)
+			{
+				keyList[j] = getKey(BenchmarkFn::getRandom(state) % count, keyKind);
+			}
+
+			HashMapFn::getBatch(map, keyList, BATCH_SIZE, valueList, UINT32_MAX);
+
+			for (uint32_t j = 0; j < BATCH_SIZE; ++j)
+			{
+				checksum += valueList[j];
+			}
+		}
+		BenchmarkFn::report("hashMapFindHitBatch", subject, 1, LOOKUP_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < LOOKUP_COUNT; ++i)
+		{
+			checksum += HashMapFn::has(map, getKey(count + BenchmarkFn::getRandom(state) % count, keyKind)) ? 1 : 0;
+		}
+		BenchmarkFn::report("hashMapFindMiss", subject, 1, LOOKUP_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		// Destroy a component and create another one, keeping the count steady
+		uint32_t nextKey = count;
+		uint32_t firstKey = 0;
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < CHURN_COUNT; ++i)
+		{
+			HashMapFn::remove(map, getKey(firstKey++, keyKind));
+			HashMapFn::set(map, getKey(nextKey++, keyKind), i);
+		}
+		BenchmarkFn::report("hashMapChurn", subject, 1, CHURN_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		sink = checksum;
+	}
+
+	void runSize(uint32_t count, KeyKind::Enum keyKind)
+	{
+		runMap<HashMap<uint32_t, uint32_t>>("HashMap", count, keyKind);
+		runMap<FlatHashMap<uint32_t, uint32_t>>("FlatHashMap", count, keyKind);
+	}
+
+} // namespace HashMapBenchmarkInternalFn
+
+void runHashMapBenchmark()
+{
+	using namespace HashMapBenchmarkInternalFn;
+
+	const uint32_t countList[] = { 1024, 64 * 1024, 1024 * 1024 };
+	for (uint32_t i = 0; i < countof(countList); ++i)
+	{
+		runSize(countList[i], KeyKind::SEQUENTIAL);
+		runSize(countList[i], KeyKind::HASHED);
+	}
+}
+
+} // namespace Rio
@@ -0,0 +1,334 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Containers/Array.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Os.h"
+#include "Core/Thread/JobSystem.h"
+#include "Core/Thread/ParallelFor.h"
+
+#include <stdio.h> // snprintf
+
+namespace Rio
+{
+
+// Synthetic CPU-bound jobs run with 1, 2, 4, ... threads up to the number of processors
+// Speedup is the elapsedNs of one thread divided by the elapsedNs of N threads
+// The parallelFor loops mimic the sprite vertex fill of RenderWorld::render() and AnimationStateMachine::update()
+// at 1k, 10k and 100k instances
+namespace JobBenchmarkInternalFn
+{
+	const uint32_t ROUND_COUNT = 20;
+	const uint32_t JOB_COUNT = 1024;
+	const uint32_t CHILD_COUNT = 16; // Jobs started by each parent job of the fork/join run
+	const uint32_t WORK_ITERATION_COUNT = 4096; // Roughly 10 microseconds per job
+	const uint32_t INSTANCE_ITEM_COUNT = 1 << 22; // Instances updated by each parallelFor run, over as many rounds as needed
+	const uint32_t FRAME_COUNT = 64;
+	const uint32_t ANIMATION_ITERATION_COUNT = 64; // Stands for the evaluation of the state machine expressions
+
+	struct WorkItem
+	{
+		uint32_t seed;
+		uint32_t result;
+	};
+
+	// Keeps the compiler from optimizing the work away
+	volatile uint64_t sink = 0;
+
+	void doWork(void* data)
+	{
+		WorkItem& workItem = *(WorkItem*)data;
+
+		uint32_t state = workItem.seed;
+		float accumulator = 0.0f;
+		for (uint32_t i = 0; i < WORK_ITERATION_COUNT; ++i)
+		{
+			accumulator = accumulator * 0.5f + float(BenchmarkFn::getRandom(state) & 0xff);
+		}
+		workItem.result = state + uint32_t(accumulator);
+	}
+
+	// Starts CHILD_COUNT jobs on the items following its own one and waits for them
+	void doParentWork(void* data)
+	{
+		WorkItem* workItemList = (WorkItem*)data;
+
+		JobDecl jobDeclList[CHILD_COUNT];
+		for (uint32_t i = 0; i < CHILD_COUNT; ++i)
+		{
+			jobDeclList[i].function = doWork;
+			jobDeclList[i].data = &workItemList[i + 1];
+		}
+
+		JobCounter counter;
+		JobSystemFn::run(jobDeclList, CHILD_COUNT, &counter);
+		doWork(&workItemList[0]);
+		JobSystemFn::wait(&counter);
+	}
+
+	uint64_t getChecksum(const WorkItem* workItemList, uint32_t count)
+	{
+		uint64_t checksum = 0;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			checksum += workItemList[i].result;
+		}
+		return checksum;
+	}
+
+	void runFlat(uint32_t threadCount)
+	{
+		static WorkItem workItemList[JOB_COUNT];
+		static JobDecl jobDeclList[JOB_COUNT];
+		for (uint32_t i = 0; i < JOB_COUNT; ++i)
+		{
+			workItemList[i].seed = i + 1;
+			jobDeclList[i].function = doWork;
+			jobDeclList[i].data = &workItemList[i];
+		}
+
+		const int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+		{
+			JobCounter counter;
+			JobSystemFn::run(jobDeclList, JOB_COUNT, &counter);
+			JobSystemFn::wait(&counter);
+		}
+		BenchmarkFn::report("jobs", "flat", threadCount, uint64_t(ROUND_COUNT) * JOB_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		sink = getChecksum(workItemList, JOB_COUNT);
+	}
+
+	void runForkJoin(uint32_t threadCount)
+	{
+		const uint32_t parentCount = JOB_COUNT / (CHILD_COUNT + 1);
+		static WorkItem workItemList[JOB_COUNT];
+		static JobDecl jobDeclList[JOB_COUNT];
+		for (uint32_t i = 0; i < JOB_COUNT; ++i)
+		{
+			workItemList[i].seed = i + 1;
+		}
+		for (uint32_t i = 0; i < parentCount; ++i)
+		{
+			jobDeclList[i].function = doParentWork;
+			jobDeclList[i].data = &workItemList[i * (CHILD_COUNT + 1)];
+		}
+
+		const int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+		{
+			JobCounter counter;
+			JobSystemFn::run(jobDeclList, parentCount, &counter);
+			JobSystemFn::wait(&counter);
+		}
+		BenchmarkFn::report("jobs", "forkJoin", threadCount, uint64_t(ROUND_COUNT) * parentCount * (CHILD_COUNT + 1), BenchmarkFn::getTimeNs() - start);
+
+		sink = getChecksum(workItemList, parentCount * (CHILD_COUNT + 1));
+	}
+
+	struct SpriteData
+	{
+		float frameData[FRAME_COUNT * 16];
+		uint32_t* frameIdList;
+		bool* flipXList;
+		float* vertexData;
+		uint16_t* indexData;
+	};
+
+	struct FillSpriteVertices
+	{
+		SpriteData* spriteData;
+
+		void operator()(uint32_t rangeBegin, uint32_t rangeEnd) const
+		{
+			float* vertexData = spriteData->vertexData + rangeBegin * 16;
+			uint16_t* indexData = spriteData->indexData + rangeBegin * 6;
+			for (uint32_t i = rangeBegin; i < rangeEnd; ++i)
+			{
+				const float* frameData = &spriteData->frameData[spriteData->frameIdList[i] * 16];
+				const bool flipX = spriteData->flipXList[i];
+				for (uint32_t j = 0; j < 4; ++j)
+				{
+					const uint32_t k = flipX ? (j ^ 1) : j;
+					vertexData[j * 4 + 0] = frameData[j * 4 + 0];
+					vertexData[j * 4 + 1] = frameData[j * 4 + 1];
+					vertexData[j * 4 + 2] = frameData[k * 4 + 2];
+					vertexData[j * 4 + 3] = frameData[k * 4 + 3];
+				}
+				vertexData += 16;
+
+				*indexData++ = uint16_t(i * 4 + 0);
+				*indexData++ = uint16_t(i * 4 + 1);
+				*indexData++ = uint16_t(i * 4 + 2);
+				*indexData++ = uint16_t(i * 4 + 0);
+				*indexData++ = uint16_t(i * 4 + 2);
+				*indexData++ = uint16_t(i * 4 + 3);
+			}
+		}
+	};
+
+	struct FrameChangeEvent
+	{
+		uint32_t instance;
+		uint32_t frameId;
+	};
+
+	struct AnimationData
+	{
+		float* timeList;
+		ParallelOutput<FrameChangeEvent>* output;
+	};
+
+	struct UpdateAnimations
+	{
+		AnimationData* animationData;
+
+		void operator()(uint32_t rangeBegin, uint32_t rangeEnd) const
+		{
+			for (uint32_t i = rangeBegin; i < rangeEnd; ++i)
+			{
+				float weight = animationData->timeList[i];
+				for (uint32_t j = 0; j < ANIMATION_ITERATION_COUNT; ++j)
+				{
+					weight = weight * 0.75f + 0.25f;
+				}
+
+				animationData->timeList[i] += 0.016f * weight;
+
+				FrameChangeEvent frameChangeEvent;
+				frameChangeEvent.instance = i;
+				frameChangeEvent.frameId = uint32_t(animationData->timeList[i] * 10.0f) % FRAME_COUNT;
+				ParallelOutputFn::write(*animationData->output, rangeBegin, frameChangeEvent);
+			}
+		}
+	};
+
+	void runSpriteFill(uint32_t threadCount, uint32_t instanceCount, const char* subject)
+	{
+		Allocator& a = getDefaultAllocator();
+
+		SpriteData spriteData;
+		for (uint32_t i = 0; i < FRAME_COUNT * 16; ++i)
+		{
+			spriteData.frameData[i] = float(i);
+		}
+		spriteData.frameIdList = (uint32_t*)a.allocate(instanceCount * sizeof(uint32_t));
+		spriteData.flipXList = (bool*)a.allocate(instanceCount * sizeof(bool));
+		spriteData.vertexData = (float*)a.allocate(instanceCount * 16 * sizeof(float));
+		spriteData.indexData = (uint16_t*)a.allocate(instanceCount * 6 * sizeof(uint16_t));
+
+		uint32_t state = 1;
+		for (uint32_t i = 0; i < instanceCount; ++i)
+		{
+			spriteData.frameIdList[i] = BenchmarkFn::getRandom(state) % FRAME_COUNT;
+			spriteData.flipXList[i] = (BenchmarkFn::getRandom(state) & 1) != 0;
+		}
+
+		FillSpriteVertices fillSpriteVertices;
+		fillSpriteVertices.spriteData = &spriteData;
+
+		const uint32_t roundCount = INSTANCE_ITEM_COUNT / instanceCount;
+		const int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < roundCount; ++round)
+		{
+			JobSystemFn::parallelFor(0, instanceCount, 0, fillSpriteVertices);
+		}
+		BenchmarkFn::report("parallelFor", subject, threadCount, uint64_t(roundCount) * instanceCount, BenchmarkFn::getTimeNs() - start);
+
+		sink = uint64_t(spriteData.vertexData[instanceCount * 16 - 1]) + spriteData.indexData[instanceCount * 6 - 1];
+
+		a.deallocate(spriteData.indexData);
+		a.deallocate(spriteData.vertexData);
+		a.deallocate(spriteData.flipXList);
+		a.deallocate(spriteData.frameIdList);
+	}
+
+	void runAnimationUpdate(uint32_t threadCount, uint32_t instanceCount, const char* subject)
+	{
+		Allocator& a = getDefaultAllocator();
+
+		ParallelOutput<FrameChangeEvent> output(a);
+		Array<FrameChangeEvent> eventList(a);
+
+		AnimationData animationData;
+		animationData.timeList = (float*)a.allocate(instanceCount * sizeof(float));
+		animationData.output = &output;
+		for (uint32_t i = 0; i < instanceCount; ++i)
+		{
+			animationData.timeList[i] = float(i % 100) * 0.01f;
+		}
+
+		UpdateAnimations updateAnimations;
+		updateAnimations.animationData = &animationData;
+
+		uint64_t checksum = 0;
+		const uint32_t roundCount = INSTANCE_ITEM_COUNT / instanceCount;
+		const int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < roundCount; ++round)
+		{
+			ParallelOutputFn::clear(output);
+			JobSystemFn::parallelFor(0, instanceCount, 0, updateAnimations);
+
+			ArrayFn::clear(eventList);
+			ParallelOutputFn::merge(output, eventList);
+			checksum += eventList[instanceCount - 1].instance;
+		}
+		BenchmarkFn::report("parallelFor", subject, threadCount, uint64_t(roundCount) * instanceCount, BenchmarkFn::getTimeNs() - start);
+
+		sink = checksum;
+
+		a.deallocate(animationData.timeList);
+	}
+
+	void runParallelFor(uint32_t threadCount)
+	{
+		const uint32_t instanceCountList[] = { 1000, 10000, 100000 };
+		for (uint32_t i = 0; i < countof(instanceCountList); ++i)
+		{
+			char subject[64];
+			snprintf(subject, sizeof(subject), "spriteFill/%uk", instanceCountList[i] / 1000);
+			runSpriteFill(threadCount, instanceCountList[i], subject);
+		}
+		for (uint32_t i = 0; i < countof(instanceCountList); ++i)
+		{
+			char subject[64];
+			snprintf(subject, sizeof(subject), "animationUpdate/%uk", instanceCountList[i] / 1000);
+			runAnimationUpdate(threadCount, instanceCountList[i], subject);
+		}
+	}
+
+} // namespace JobBenchmarkInternalFn
+
+void runJobBenchmark()
+{
+	using namespace JobBenchmarkInternalFn;
+
+	const uint32_t processorCount = OsFn::getProcessorCount();
+	for (uint32_t threadCount = 1; ; threadCount *= 2)
+	{
+		if (threadCount > processorCount)
+		{
+			threadCount = processorCount;
+		}
+
+		// Worker count 0 means one per processor, so a single thread runs everything inline
+		if (threadCount > 1)
+		{
+			JobSystemGlobalFn::init(threadCount - 1);
+		}
+
+		runFlat(threadCount);
+		runForkJoin(threadCount);
+		runParallelFor(threadCount);
+
+		if (threadCount > 1)
+		{
+			JobSystemGlobalFn::shutdown();
+		}
+
+		if (threadCount == processorCount)
+		{
+			break;
+		}
+	}
+}
+
+} // namespace Rio
@@ -0,0 +1,115 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Containers/Map.h"
+#include "Core/Json/JsonObject.h"
+#include "Core/Json/RJson.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/TempAllocator.h"
+#include "Core/Strings/DynamicString.h"
+
+#include <stdio.h> // snprintf
+
+namespace Rio
+{
+
+// Objects the size of component data, unit lists and shader state lists, built and queried like the data compilers do
+// The Map<FixedString, const char*> JsonObject used to wrap is measured on the same keys
+namespace JsonBenchmarkInternalFn
+{
+	const uint32_t ROUND_COUNT = 20000;
+	const uint32_t MAX_KEY_COUNT = 64;
+
+	// Keeps the compiler from optimizing the lookups away
+	volatile uintptr_t sink = 0;
+
+	void createObject(DynamicString& json, char (*keyList)[32], uint32_t keyCount)
+	{
+		for (uint32_t i = 0; i < keyCount; ++i)
+		{
+			snprintf(keyList[i], sizeof(keyList[i]), "componentProperty%u", i);
+
+			char line[64];
+			snprintf(line, sizeof(line), "%s = %u\n", keyList[i], i);
+			json += line;
+		}
+	}
+
+	void runSize(uint32_t keyCount)
+	{
+		char subject[64];
+		char keyList[MAX_KEY_COUNT][32];
+
+		DynamicString json(getDefaultAllocator());
+		createObject(json, keyList, keyCount);
+
+		JsonObject parsedJsonObject(getDefaultAllocator());
+		RJsonFn::parse(json.getCStr(), parsedJsonObject);
+		const JsonObject::Node* begin = JsonObjectFn::begin(parsedJsonObject);
+		const JsonObject::Node* end = JsonObjectFn::end(parsedJsonObject);
+
+		uintptr_t checksum = 0;
+
+		// Insert every key, then look every one of them up by name
+		int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+		{
+			TempAllocator4096 tempAllocator4096;
+			Map<FixedString, const char*> jsonMap(tempAllocator4096);
+			for (const JsonObject::Node* node = begin; node != end; ++node)
+			{
+				MapFn::set(jsonMap, node->pair.first, node->pair.second);
+			}
+
+			for (uint32_t i = 0; i < keyCount; ++i)
+			{
+				checksum += (uintptr_t)MapFn::get(jsonMap, FixedString(keyList[i]), (const char*)nullptr);
+			}
+		}
+		snprintf(subject, sizeof(subject), "Map/%u", keyCount);
+		BenchmarkFn::report("jsonObjectBuildAndLookup", subject, 1, uint64_t(ROUND_COUNT) * keyCount, BenchmarkFn::getTimeNs() - start);
+
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+		{
+			TempAllocator4096 tempAllocator4096;
+			JsonObject jsonObject(tempAllocator4096);
+			for (const JsonObject::Node* node = begin; node != end; ++node)
+			{
+				JsonObjectFn::set(jsonObject, node->pair.first, node->pair.second);
+			}
+
+			for (uint32_t i = 0; i < keyCount; ++i)
+			{
+				checksum += (uintptr_t)jsonObject[keyList[i]];
+			}
+		}
+		snprintf(subject, sizeof(subject), "JsonObject/%u", keyCount);
+		BenchmarkFn::report("jsonObjectBuildAndLookup", subject, 1, uint64_t(ROUND_COUNT) * keyCount, BenchmarkFn::getTimeNs() - start);
+
+		// Whole RJsonFn::parse() for reference, the key parsing is shared by both
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+		{
+			TempAllocator4096 tempAllocator4096;
+			JsonObject jsonObject(tempAllocator4096);
+			RJsonFn::parse(json.getCStr(), jsonObject);
+			checksum += JsonObjectFn::getSize(jsonObject);
+		}
+		BenchmarkFn::report("rJsonParse", subject, 1, uint64_t(ROUND_COUNT) * keyCount, BenchmarkFn::getTimeNs() - start);
+
+		sink = checksum;
+	}
+
+} // namespace JsonBenchmarkInternalFn
+
+void runJsonBenchmark()
+{
+	using namespace JsonBenchmarkInternalFn;
+
+	const uint32_t keyCountList[] = { 4, 16, MAX_KEY_COUNT };
+	for (uint32_t i = 0; i < countof(keyCountList); ++i)
+	{
+		runSize(keyCountList[i]);
+	}
+}
+
+} // namespace Rio
@@ -0,0 +1,210 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Containers/MpmcQueue.h"
+#include "Core/Containers/Queue.h"
+#include "Core/Containers/SpscQueue.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Thread/Mutex.h"
+#include "Core/Thread/Thread.h"
+
+namespace Rio
+{
+
+// Producers push ITEM_COUNT items in total through a queue of CAPACITY items while consumers pop them
+// Full and empty queues make the thread spin, yielding every few failed attempts
+namespace QueueBenchmarkInternalFn
+{
+	const uint32_t MAX_THREADS = 8;
+	const uint32_t CAPACITY = 1024;
+	const uint32_t ITEM_COUNT = 1 << 22;
+	const uint32_t SPIN_COUNT = 64;
+
+	// Keeps the compiler from optimizing the pops away
+	volatile uint64_t sink = 0;
+
+	// Queue<T> behind a Mutex, like ResourceLoader used, bounded to CAPACITY as well
+	struct LockedQueue
+	{
+		Mutex mutex;
+		Queue<uint32_t> queue;
+
+		LockedQueue()
+			: queue(getDefaultAllocator())
+		{
+			QueueFn::increaseCapacity(queue, CAPACITY);
+		}
+	};
+
+	using SpscQueueType = SpscQueue<uint32_t, CAPACITY>;
+	using MpmcQueueType = MpmcQueue<uint32_t, CAPACITY>;
+
+	inline bool push(LockedQueue& q, uint32_t item)
+	{
+		ScopedMutex scopedMutex(q.mutex);
+		if (QueueFn::getCount(q.queue) == CAPACITY)
+		{
+			return false;
+		}
+
+		QueueFn::pushBack(q.queue, item);
+		return true;
+	}
+
+	inline bool pop(LockedQueue& q, uint32_t& item)
+	{
+		ScopedMutex scopedMutex(q.mutex);
+		if (QueueFn::getIsEmpty(q.queue))
+		{
+			return false;
+		}
+
+		item = QueueFn::getFront(q.queue);
+		QueueFn::popFront(q.queue);
+		return true;
+	}
+
+	inline bool push(SpscQueueType& q, uint32_t item)
+	{
+		return SpscQueueFn::push(q, item);
+	}
+
+	inline bool pop(SpscQueueType& q, uint32_t& item)
+	{
+		return SpscQueueFn::pop(q, item);
+	}
+
+	inline bool push(MpmcQueueType& q, uint32_t item)
+	{
+		return MpmcQueueFn::push(q, item);
+	}
+
+	inline bool pop(MpmcQueueType& q, uint32_t& item)
+	{
+		return MpmcQueueFn::pop(q, item);
+	}
+
+	template <typename TQueue>
+	struct Context;
+
+	template <typename TQueue>
+	struct Worker
+	{
+		Context<TQueue>* context = nullptr;
+		uint32_t itemCount = 0;
+		uint64_t checksum = 0;
+	};
+
+	template <typename TQueue>
+	struct Context
+	{
+		TQueue* queue = nullptr;
+		SpinBarrier startBarrier; // Workers and the timing thread
+		Worker<TQueue> workerList[MAX_THREADS];
+
+		Context(TQueue& queue, uint32_t threadCount)
+			: queue(&queue)
+			, startBarrier(threadCount + 1)
+		{
+		}
+	};
+
+	template <typename TQueue>
+	static int32_t produce(void* data)
+	{
+		Worker<TQueue>& worker = *(Worker<TQueue>*)data;
+		TQueue& queue = *worker.context->queue;
+		worker.context->startBarrier.wait();
+
+		for (uint32_t i = 0; i < worker.itemCount; ++i)
+		{
+			for (uint32_t attempt = 1; !push(queue, i); ++attempt)
+			{
+				if (attempt % SPIN_COUNT == 0)
+				{
+					BenchmarkFn::yield();
+				}
+			}
+		}
+
+		return 0;
+	}
+
+	template <typename TQueue>
+	static int32_t consume(void* data)
+	{
+		Worker<TQueue>& worker = *(Worker<TQueue>*)data;
+		TQueue& queue = *worker.context->queue;
+		worker.context->startBarrier.wait();
+
+		uint32_t item = 0;
+		for (uint32_t i = 0; i < worker.itemCount; ++i)
+		{
+			for (uint32_t attempt = 1; !pop(queue, item); ++attempt)
+			{
+				if (attempt % SPIN_COUNT == 0)
+				{
+					BenchmarkFn::yield();
+				}
+			}
+			worker.checksum += item;
+		}
+
+		return 0;
+	}
+
+	// Runs <producerCount> producers and as many consumers on a new TQueue
+	template <typename TQueue>
+	void run(const char* subject, uint32_t producerCount)
+	{
+		const uint32_t threadCount = producerCount * 2;
+
+		TQueue* queue = RIO_NEW(getDefaultAllocator(), TQueue)();
+		Context<TQueue> context(*queue, threadCount);
+		Thread threadList[MAX_THREADS];
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			Worker<TQueue>& worker = context.workerList[i];
+			worker.context = &context;
+			worker.itemCount = ITEM_COUNT / producerCount;
+			threadList[i].start(i < producerCount ? produce<TQueue> : consume<TQueue>, &worker);
+		}
+
+		context.startBarrier.wait();
+		const int64_t start = BenchmarkFn::getTimeNs();
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			threadList[i].stop();
+		}
+
+		const int64_t elapsed = BenchmarkFn::getTimeNs() - start;
+		BenchmarkFn::report("queueTransfer", subject, threadCount, ITEM_COUNT, elapsed);
+
+		uint64_t checksum = 0;
+		for (uint32_t i = producerCount; i < threadCount; ++i)
+		{
+			checksum += context.workerList[i].checksum;
+		}
+		sink = checksum;
+
+		RIO_DELETE(getDefaultAllocator(), queue);
+	}
+
+} // namespace QueueBenchmarkInternalFn
+
+void runQueueBenchmark()
+{
+	using namespace QueueBenchmarkInternalFn;
+
+	run<LockedQueue>("Mutex+Queue", 1);
+	run<SpscQueueType>("SpscQueue", 1);
+	run<MpmcQueueType>("MpmcQueue", 1);
+
+	for (uint32_t producerCount = 2; producerCount * 2 <= MAX_THREADS; producerCount *= 2)
+	{
+		run<LockedQueue>("Mutex+Queue", producerCount);
+		run<MpmcQueueType>("MpmcQueue", producerCount);
+	}
+}
+
+} // namespace Rio
@@ -0,0 +1,159 @@
+#include "Benchmark/Benchmark.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Containers/SortMap.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Murmur.h"
+#include "Core/Strings/StringId.h"
+
+namespace Rio
+{
+
+// The table of ResourceManager, loading a package of RESOURCE_COUNT resources
+// ResourceManager itself needs a data directory and the loader thread, so its table is reproduced here:
+// the hashed ResourceManager::ResourceMap against the SortMap it replaced, which was sorted after every insert and remove
+namespace ResourceTableBenchmarkInternalFn
+{
+	const uint32_t RESOURCE_COUNT = 10000;
+	const uint32_t TYPE_COUNT = 8;
+	const uint32_t LOOKUP_ROUND_COUNT = 100;
+
+	// Keeps the compiler from optimizing the lookups away
+	volatile uintptr_t sink = 0;
+
+	// Same as ResourceManager::ResourcePair and ResourceManager::ResourceEntry
+	struct ResourcePair
+	{
+		StringId64 type;
+		StringId64 name;
+
+		bool operator==(const ResourcePair& resourcePair) const
+		{
+			return type == resourcePair.type && name == resourcePair.name;
+		}
+
+		// Order of the SortMap
+		bool operator<(const ResourcePair& resourcePair) const
+		{
+			return type < resourcePair.type || (type == resourcePair.type && name < resourcePair.name);
+		}
+	};
+
+	struct ResourcePairHash
+	{
+		HASH_IS_MIXED;
+
+		uint32_t operator()(const ResourcePair& resourcePair) const
+		{
+			return HashFn::mix(resourcePair.type.id ^ resourcePair.name.id);
+		}
+	};
+
+	struct ResourceEntry
+	{
+		uint32_t referencesCount = 0;
+		void* data = nullptr;
+	};
+
+	using HashedResourceMap = HashMap<ResourcePair, ResourceEntry, ResourcePairHash>;
+	using SortedResourceMap = SortMap<ResourcePair, ResourceEntry>;
+
+	// Resource names are hashed paths, spread over a few types
+	void createPackage(Array<ResourcePair>& resourcePairList)
+	{
+		for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+		{
+			const uint32_t typeIndex = i % TYPE_COUNT;
+
+			ResourcePair resourcePair;
+			resourcePair.type.id = murmur64(&typeIndex, sizeof(typeIndex), 0);
+			resourcePair.name.id = murmur64(&i, sizeof(i), 0);
+			ArrayFn::pushBack(resourcePairList, resourcePair);
+		}
+	}
+
+	// Every completed load request inserts its resource, then the package is looked up by the game and unloaded
+	void runSorted(const Array<ResourcePair>& resourcePairList)
+	{
+		SortedResourceMap resourceMap(getDefaultAllocator());
+		ResourceEntry resourceEntry;
+		resourceEntry.referencesCount = 1;
+
+		int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+		{
+			SortMapFn::set(resourceMap, resourcePairList[i], resourceEntry);
+			SortMapFn::sort(resourceMap);
+		}
+		BenchmarkFn::report("resourcePackageLoad", "SortMap", 1, RESOURCE_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		uintptr_t checksum = 0;
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < LOOKUP_ROUND_COUNT; ++round)
+		{
+			for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+			{
+				checksum += SortMapFn::get(resourceMap, resourcePairList[i], resourceEntry).referencesCount;
+			}
+		}
+		BenchmarkFn::report("resourceLookup", "SortMap", 1, RESOURCE_COUNT * LOOKUP_ROUND_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+		{
+			SortMapFn::remove(resourceMap, resourcePairList[i]);
+			SortMapFn::sort(resourceMap);
+		}
+		BenchmarkFn::report("resourcePackageUnload", "SortMap", 1, RESOURCE_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		sink = checksum;
+	}
+
+	void runHashed(const Array<ResourcePair>& resourcePairList)
+	{
+		HashedResourceMap resourceMap(getDefaultAllocator());
+		ResourceEntry resourceEntry;
+		resourceEntry.referencesCount = 1;
+
+		int64_t start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+		{
+			HashMapFn::set(resourceMap, resourcePairList[i], resourceEntry);
+		}
+		BenchmarkFn::report("resourcePackageLoad", "HashMap", 1, RESOURCE_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		uintptr_t checksum = 0;
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t round = 0; round < LOOKUP_ROUND_COUNT; ++round)
+		{
+			for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+			{
+				checksum += HashMapFn::get(resourceMap, resourcePairList[i], resourceEntry).referencesCount;
+			}
+		}
+		BenchmarkFn::report("resourceLookup", "HashMap", 1, RESOURCE_COUNT * LOOKUP_ROUND_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		start = BenchmarkFn::getTimeNs();
+		for (uint32_t i = 0; i < RESOURCE_COUNT; ++i)
+		{
+			HashMapFn::remove(resourceMap, resourcePairList[i]);
+		}
+		BenchmarkFn::report("resourcePackageUnload", "HashMap", 1, RESOURCE_COUNT, BenchmarkFn::getTimeNs() - start);
+
+		sink = checksum;
+	}
+
+} // namespace ResourceTableBenchmarkInternalFn
+
+void runResourceTableBenchmark()
+{
+	using namespace ResourceTableBenchmarkInternalFn;
+
+	Array<ResourcePair> resourcePairList(getDefaultAllocator());
+	createPackage(resourcePairList);
+
+	runSorted(resourcePairList);
+	runHashed(resourcePairList);
+}
+
+} // namespace Rio
@@ -10,4 +10,10 @@
 	#define RIO_DEVELOPMENT 0
 #endif // RIO_DEVELOPMENT
 
-#define RIO_RELEASE (!RIO_DEBUG && !RIO_DEVELOPMENT)
\ No newline at end of file
+#define RIO_RELEASE (!RIO_DEBUG && !RIO_DEVELOPMENT)
+
+// Wraps the default allocator with a TrackingAllocator which records the call site of every allocation
+// Costs a stack walk and a global lock per allocation, so it is off unless a soak build defines RIO_MEMORY_TRACKING=1
+#ifndef RIO_MEMORY_TRACKING
+	#define RIO_MEMORY_TRACKING 0
+#endif // RIO_MEMORY_TRACKING
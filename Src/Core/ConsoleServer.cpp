@@ -1,6 +1,6 @@
 #include "Core/ConsoleServer.h"
 
-#include "Core/Containers/HashMap.h"
+#include "Core/Containers/FlatHashMap.h"
 #include "Core/Json/JsonObject.h"
 #include "Core/Json/RJson.h"
 #include "Core/Memory/TempAllocator.h"
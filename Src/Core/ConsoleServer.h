@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Core/Containers/HashMap.h"
+#include "Core/Containers/FlatHashMap.h"
 #include "Core/Containers/Types.h"
 #include "Core/Network/Socket.h"
 #include "Core/Strings/Types.h"
@@ -21,7 +21,7 @@ struct ConsoleServer
 
 	TcpSocket server;
 	Array<TcpSocket> clientList;
-	HashMap<StringId32, Command> commandMap;
+	FlatHashMap<StringId32, Command> commandMap;
 
 	explicit ConsoleServer(Allocator& a);
 
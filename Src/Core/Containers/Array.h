@@ -130,13 +130,8 @@ namespace ArrayFn
 
 		if (capacity > 0)
 		{
-			T* tmp = a.data;
+			a.data = (T*)a.allocator->reallocate(a.data, a.size * sizeof(T), capacity * sizeof(T), alignof(T));
 			a.capacity = capacity;
-			a.data = (T*)a.allocator->allocate(capacity * sizeof(T), alignof(T));
-
-			memcpy(a.data, tmp, a.size * sizeof(T));
-
-			a.allocator->deallocate(tmp);
 		}
 	}
 
@@ -0,0 +1,497 @@
+#pragma once
+
+#include "Core/Containers/Types.h"
+#include "Core/Platform.h"
+
+#include <new>
+#include <cstring> // memcpy, memset
+
+#if RIO_SIMD_SSE2
+	#include <emmintrin.h>
+#endif
+
+#if RIO_COMPILER_MSVC
+	#include <intrin.h> // _BitScanForward
+#endif
+
+namespace Rio
+{
+
+// FlatHashMap is a drop-in replacement for HashMap, see Core/Containers/HashMap.h for the documentation
+namespace HashMapFn
+{
+	template <typename TKey, typename TValue, typename THash> uint32_t getCount(const FlatHashMap<TKey, TValue, THash>& m);
+	template <typename TKey, typename TValue, typename THash> uint32_t getCapacity(const FlatHashMap<TKey, TValue, THash>& m);
+	template <typename TKey, typename TValue, typename THash> bool has(const FlatHashMap<TKey, TValue, THash>& m, const TKey& key);
+	template <typename TKey, typename TValue, typename THash> const TValue& get(const FlatHashMap<TKey, TValue, THash>& m, const TKey& key, const TValue& deffault);
+	template <typename TKey, typename TValue, typename THash> void getBatch(const FlatHashMap<TKey, TValue, THash>& m, const TKey* keyList, uint32_t count, TValue* valueList, const TValue& deffault);
+	template <typename TKey, typename TValue, typename THash> void set(FlatHashMap<TKey, TValue, THash>& m, const TKey& key, const TValue& value);
+	template <typename TKey, typename TValue, typename THash> void remove(FlatHashMap<TKey, TValue, THash>& m, const TKey& key);
+	template <typename TKey, typename TValue, typename THash> void clear(FlatHashMap<TKey, TValue, THash>& m);
+	template <typename TKey, typename TValue, typename THash> const typename FlatHashMap<TKey, TValue, THash>::Entry* begin(const FlatHashMap<TKey, TValue, THash>& m);
+	template <typename TKey, typename TValue, typename THash> const typename FlatHashMap<TKey, TValue, THash>::Entry* end(const FlatHashMap<TKey, TValue, THash>& m);
+	template <typename TKey, typename TValue, typename THash> bool getIsHole(const FlatHashMap<TKey, TValue, THash>& m, const typename FlatHashMap<TKey, TValue, THash>::Entry* entry);
+	template <typename TKey, typename TValue, typename THash> void reserve(FlatHashMap<TKey, TValue, THash>& m, uint32_t size);
+	template <typename TKey, typename TValue, typename THash> void shrinkToFit(FlatHashMap<TKey, TValue, THash>& m);
+
+	// The probe length of an item is the number of groups visited before the one holding it
+	template <typename TKey, typename TValue, typename THash> uint32_t getProbeLengthHistogram(const FlatHashMap<TKey, TValue, THash>& m, uint32_t* histogram, uint32_t count);
+
+} // namespace HashMapFn
+
+namespace FlatHashMapInternalFn
+{
+	const uint32_t END_OF_LIST = 0xffffffffu;
+	const uint32_t GROUP_SIZE = 16;
+	const uint32_t BATCH_SIZE = 16; // Lookups in flight in getBatch()
+
+	// Control byte of a slot
+	// Used slots store the 7-bit tag of their hash, free slots have the high bit set
+	const uint8_t EMPTY = 0x80;
+	const uint8_t DELETED = 0xfe;
+
+	// Uses Hash templates from Core/Functional.h
+	// Both the group index and the tag need well spread bits, so hashes are mixed unless they are marked HASH_IS_MIXED
+	template <typename TKey, typename THash>
+	inline uint32_t getHashKey(const TKey& key, Int2Type<true>)
+	{
+		const THash hash;
+		return hash(key);
+	}
+
+	template <typename TKey, typename THash>
+	inline uint32_t getHashKey(const TKey& key, Int2Type<false>)
+	{
+		const THash hash;
+		return HashFn::mix(hash(key));
+	}
+
+	template <typename TKey, typename THash>
+	inline uint32_t getHashKey(const TKey& key)
+	{
+		return getHashKey<TKey, THash>(key, Int2Type<IS_HASH_MIXED(THash)>());
+	}
+
+	inline uint8_t getTag(uint32_t hash)
+	{
+		return uint8_t(hash >> 25);
+	}
+
+	inline bool getIsUsed(uint8_t control)
+	{
+		return (control & 0x80) == 0;
+	}
+
+	// Returns a mask with bit i set if the i-th control byte of <group> equals <control>
+	inline uint32_t match(const uint8_t* group, uint8_t control)
+	{
+#if RIO_SIMD_SSE2
+		const __m128i controlList = _mm_load_si128((const __m128i*)group);
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(controlList, _mm_set1_epi8((char)control)));
+#else
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < GROUP_SIZE; ++i)
+		{
+			mask |= uint32_t(group[i] == control) << i;
+		}
+		return mask;
+#endif
+	}
+
+	// Returns a mask with bit i set if the i-th slot of <group> is empty or deleted
+	inline uint32_t matchFree(const uint8_t* group)
+	{
+#if RIO_SIMD_SSE2
+		return (uint32_t)_mm_movemask_epi8(_mm_load_si128((const __m128i*)group));
+#else
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < GROUP_SIZE; ++i)
+		{
+			mask |= uint32_t(group[i] >> 7) << i;
+		}
+		return mask;
+#endif
+	}
+
+	// Returns the index of the lowest set bit in <mask>, which must not be 0
+	inline uint32_t getFirstBit(uint32_t mask)
+	{
+#if RIO_COMPILER_MSVC
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return (uint32_t)index;
+#else
+		return (uint32_t)__builtin_ctz(mask);
+#endif
+	}
+
+	// Probing visits groups with triangular steps (+1, +2, +3...)
+	// With a power of two group count, every group is visited once
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t find(const FlatHashMap<TKey, TValue, THash>& m, const TKey& key, uint32_t hash)
+	{
+		if (m.size == 0)
+		{
+			return END_OF_LIST;
+		}
+
+		const uint8_t tag = getTag(hash);
+		uint32_t groupIndex = hash & m.groupMask;
+		for (uint32_t step = 1; ; ++step)
+		{
+			const uint8_t* group = m.controlList + groupIndex * GROUP_SIZE;
+			for (uint32_t mask = match(group, tag); mask != 0; mask &= mask - 1)
+			{
+				const uint32_t i = groupIndex * GROUP_SIZE + getFirstBit(mask);
+				if (m.data[i].first == key)
+				{
+					return i;
+				}
+			}
+
+			// Keys are never placed past a group with an empty slot
+			if (match(group, EMPTY) != 0)
+			{
+				return END_OF_LIST;
+			}
+
+			groupIndex = (groupIndex + step) & m.groupMask;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t find(const FlatHashMap<TKey, TValue, THash>& m, const TKey& key)
+	{
+		if (m.size == 0)
+		{
+			return END_OF_LIST;
+		}
+
+		return find(m, key, getHashKey<TKey, THash>(key));
+	}
+
+	// Returns the first empty or deleted slot in the probe sequence of <hash>
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t findFreeSlot(const FlatHashMap<TKey, TValue, THash>& m, uint32_t hash)
+	{
+		uint32_t groupIndex = hash & m.groupMask;
+		for (uint32_t step = 1; ; ++step)
+		{
+			const uint32_t mask = matchFree(m.controlList + groupIndex * GROUP_SIZE);
+			if (mask != 0)
+			{
+				return groupIndex * GROUP_SIZE + getFirstBit(mask);
+			}
+
+			groupIndex = (groupIndex + step) & m.groupMask;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void rehash(FlatHashMap<TKey, TValue, THash>& m, uint32_t newCapacity)
+	{
+		typedef typename FlatHashMap<TKey, TValue, THash>::Entry Entry;
+
+		uint8_t* controlList = m.controlList;
+		Entry* data = m.data;
+		const uint32_t capacity = m.capacity;
+
+		m.controlList = (uint8_t*)m.allocator->allocate(newCapacity, GROUP_SIZE);
+		m.data = (Entry*)m.allocator->allocate(newCapacity * sizeof(Entry), alignof(Entry));
+		memset(m.controlList, EMPTY, newCapacity);
+		m.capacity = newCapacity;
+		m.deletedCount = 0;
+		m.groupMask = newCapacity / GROUP_SIZE - 1;
+
+		for (uint32_t i = 0; i < capacity; ++i)
+		{
+			if (getIsUsed(controlList[i]))
+			{
+				const uint32_t hash = getHashKey<TKey, THash>(data[i].first);
+				const uint32_t j = findFreeSlot(m, hash);
+				m.controlList[j] = getTag(hash);
+				memcpy((void*)(m.data + j), (void*)(data + i), sizeof(Entry));
+			}
+		}
+
+		m.allocator->deallocate(controlList);
+		m.allocator->deallocate(data);
+	}
+
+	// Returns the smallest capacity which holds <size> items under the load limit
+	inline uint32_t getCapacityFor(uint32_t size)
+	{
+		uint32_t capacity = GROUP_SIZE;
+		while (size * 8 > capacity * 7)
+		{
+			capacity *= 2;
+		}
+		return capacity;
+	}
+
+	// Makes room for one more item, keeping used and deleted slots under 7/8 of the capacity
+	template <typename TKey, typename TValue, typename THash>
+	void reserveOne(FlatHashMap<TKey, TValue, THash>& m)
+	{
+		if (m.capacity == 0)
+		{
+			rehash(m, GROUP_SIZE);
+		}
+		else if ((m.size + m.deletedCount + 1) * 8 > m.capacity * 7)
+		{
+			// Mostly deleted slots: rehash at the same capacity to reclaim them
+			const uint32_t newCapacity = (m.size + 1) * 2 > m.capacity ? m.capacity * 2 : m.capacity;
+			rehash(m, newCapacity);
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void insert(FlatHashMap<TKey, TValue, THash>& m, uint32_t hash, const TKey& key, const TValue& value)
+	{
+		typedef typename FlatHashMap<TKey, TValue, THash>::Entry Entry;
+
+		const uint32_t i = findFreeSlot(m, hash);
+		if (m.controlList[i] == DELETED)
+		{
+			--m.deletedCount;
+		}
+
+		m.controlList[i] = getTag(hash);
+		new (m.data + i) Entry(*m.allocator);
+		m.data[i].first = key;
+		m.data[i].second = value;
+		++m.size;
+	}
+
+} // namespace FlatHashMapInternalFn
+
+namespace HashMapFn
+{
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t getCount(const FlatHashMap<TKey, TValue, THash>& m)
+	{
+		return m.size;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t getCapacity(const FlatHashMap<TKey, TValue, THash>& m)
+	{
+		return m.capacity;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	bool has(const FlatHashMap<TKey, TValue, THash>& m, const TKey& key)
+	{
+		return FlatHashMapInternalFn::find(m, key) != FlatHashMapInternalFn::END_OF_LIST;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	const TValue& get(const FlatHashMap<TKey, TValue, THash>& m, const TKey& key, const TValue& deffault)
+	{
+		const uint32_t i = FlatHashMapInternalFn::find(m, key);
+		if (i == FlatHashMapInternalFn::END_OF_LIST)
+		{
+			return deffault;
+		}
+		else
+		{
+			return m.data[i].second;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void getBatch(const FlatHashMap<TKey, TValue, THash>& m, const TKey* keyList, uint32_t count, TValue* valueList, const TValue& deffault)
+	{
+		using namespace FlatHashMapInternalFn;
+
+		if (m.size == 0)
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				valueList[i] = deffault;
+			}
+			return;
+		}
+
+		uint32_t hashList[BATCH_SIZE];
+		for (uint32_t first = 0; first < count; first += BATCH_SIZE)
+		{
+			const uint32_t batchCount = (count - first < BATCH_SIZE) ? count - first : BATCH_SIZE;
+
+			for (uint32_t i = 0; i < batchCount; ++i)
+			{
+				hashList[i] = getHashKey<TKey, THash>(keyList[first + i]);
+				const uint32_t slot = (hashList[i] & m.groupMask) * GROUP_SIZE;
+				RIO_PREFETCH(m.controlList + slot);
+				RIO_PREFETCH(m.data + slot);
+			}
+
+			for (uint32_t i = 0; i < batchCount; ++i)
+			{
+				const uint32_t slot = find(m, keyList[first + i], hashList[i]);
+				valueList[first + i] = (slot == END_OF_LIST) ? deffault : m.data[slot].second;
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void set(FlatHashMap<TKey, TValue, THash>& m, const TKey& key, const TValue& value)
+	{
+		const uint32_t i = FlatHashMapInternalFn::find(m, key);
+		if (i != FlatHashMapInternalFn::END_OF_LIST)
+		{
+			m.data[i].second = value;
+			return;
+		}
+
+		FlatHashMapInternalFn::reserveOne(m);
+		FlatHashMapInternalFn::insert(m, FlatHashMapInternalFn::getHashKey<TKey, THash>(key), key, value);
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void remove(FlatHashMap<TKey, TValue, THash>& m, const TKey& key)
+	{
+		using namespace FlatHashMapInternalFn;
+
+		const uint32_t i = find(m, key);
+		if (i == END_OF_LIST)
+		{
+			return;
+		}
+
+		m.data[i].~Pair();
+		--m.size;
+
+		// If the group still has an empty slot no probe goes past it, so the slot can be emptied
+		// Otherwise it must stay in the probe sequence as a tombstone
+		if (match(m.controlList + (i & ~(GROUP_SIZE - 1)), EMPTY) != 0)
+		{
+			m.controlList[i] = EMPTY;
+		}
+		else
+		{
+			m.controlList[i] = DELETED;
+			++m.deletedCount;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void clear(FlatHashMap<TKey, TValue, THash>& m)
+	{
+		for (uint32_t i = 0; i < m.capacity; ++i)
+		{
+			if (FlatHashMapInternalFn::getIsUsed(m.controlList[i]))
+			{
+				m.data[i].~Pair();
+			}
+		}
+
+		if (m.capacity != 0)
+		{
+			memset(m.controlList, FlatHashMapInternalFn::EMPTY, m.capacity);
+		}
+
+		m.size = 0;
+		m.deletedCount = 0;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	const typename FlatHashMap<TKey, TValue, THash>::Entry* begin(const FlatHashMap<TKey, TValue, THash>& m)
+	{
+		return m.data;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	const typename FlatHashMap<TKey, TValue, THash>::Entry* end(const FlatHashMap<TKey, TValue, THash>& m)
+	{
+		return m.data + m.capacity;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	bool getIsHole(const FlatHashMap<TKey, TValue, THash>& m, const typename FlatHashMap<TKey, TValue, THash>::Entry* entry)
+	{
+		return !FlatHashMapInternalFn::getIsUsed(m.controlList[entry - m.data]);
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void reserve(FlatHashMap<TKey, TValue, THash>& m, uint32_t size)
+	{
+		const uint32_t capacity = FlatHashMapInternalFn::getCapacityFor(size);
+		if (capacity > m.capacity)
+		{
+			FlatHashMapInternalFn::rehash(m, capacity);
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void shrinkToFit(FlatHashMap<TKey, TValue, THash>& m)
+	{
+		// Also drops the tombstones
+		const uint32_t capacity = FlatHashMapInternalFn::getCapacityFor(m.size);
+		if (capacity < m.capacity || m.deletedCount != 0)
+		{
+			FlatHashMapInternalFn::rehash(m, capacity);
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t getProbeLengthHistogram(const FlatHashMap<TKey, TValue, THash>& m, uint32_t* histogram, uint32_t count)
+	{
+		using namespace FlatHashMapInternalFn;
+
+		memset(histogram, 0, count * sizeof(uint32_t));
+
+		uint32_t maxLength = 0;
+		for (uint32_t i = 0; i < m.capacity; ++i)
+		{
+			if (!getIsUsed(m.controlList[i]))
+			{
+				continue;
+			}
+
+			// Walks the probe sequence of the key up to the group of the item
+			uint32_t groupIndex = getHashKey<TKey, THash>(m.data[i].first) & m.groupMask;
+			uint32_t length = 0;
+			while (groupIndex != i / GROUP_SIZE)
+			{
+				++length;
+				groupIndex = (groupIndex + length) & m.groupMask;
+			}
+
+			++histogram[length < count ? length : count - 1];
+			maxLength = length > maxLength ? length : maxLength;
+		}
+
+		return maxLength;
+	}
+
+} // namespace HashMapFn
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>::FlatHashMap(Allocator& a)
+	: allocator(&a)
+{
+}
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>::~FlatHashMap()
+{
+	for (uint32_t i = 0; i < capacity; ++i)
+	{
+		if (FlatHashMapInternalFn::getIsUsed(controlList[i]))
+		{
+			data[i].~Pair();
+		}
+	}
+
+	allocator->deallocate(controlList);
+	allocator->deallocate(data);
+}
+
+template <typename TKey, typename TValue, typename THash>
+const TValue& FlatHashMap<TKey, TValue, THash>::operator[](const TKey& key) const
+{
+	return HashMapFn::get(*this, key, TValue());
+}
+
+} // namespace Rio
@@ -23,6 +23,10 @@ namespace HashMapFn
 	// Returns the value for the given <key> or <deffault> if the key does not exist in the map
 	template <typename TKey, typename TValue, typename THash> const TValue& get(const HashMap<TKey, TValue, THash>& m, const TKey& key, const TValue& deffault);
 
+	// Writes the values of the <count> keys in <keyList> to <valueList>, or <deffault> for the keys which do not exist in the map
+	// Keys are hashed and their slots prefetched a batch at a time, so the cache misses of the lookups overlap
+	template <typename TKey, typename TValue, typename THash> void getBatch(const HashMap<TKey, TValue, THash>& m, const TKey* keyList, uint32_t count, TValue* valueList, const TValue& deffault);
+
 	// Sets the <value> for the <key> in the map
 	template <typename TKey, typename TValue, typename THash> void set(HashMap<TKey, TValue, THash>& m, const TKey& key, const TValue& value);
 
@@ -33,13 +37,35 @@ namespace HashMapFn
 	// Calls destructor on the items
 	template <typename TKey, typename TValue, typename THash> void clear(HashMap<TKey, TValue, THash>& m);
 
+	// Returns a pointer to the first slot of the map <m>
+	// Slots are not all used, skip the holes with getIsHole() when iterating up to end()
+	template <typename TKey, typename TValue, typename THash> const typename HashMap<TKey, TValue, THash>::Entry* begin(const HashMap<TKey, TValue, THash>& m);
+
+	// Returns a pointer past the last slot of the map <m>
+	template <typename TKey, typename TValue, typename THash> const typename HashMap<TKey, TValue, THash>::Entry* end(const HashMap<TKey, TValue, THash>& m);
+
+	// Returns whether the slot <entry> of the map <m> holds no item
+	template <typename TKey, typename TValue, typename THash> bool getIsHole(const HashMap<TKey, TValue, THash>& m, const typename HashMap<TKey, TValue, THash>::Entry* entry);
+
+	// Makes sure the map <m> can hold <size> items without rehashing
+	template <typename TKey, typename TValue, typename THash> void reserve(HashMap<TKey, TValue, THash>& m, uint32_t size);
+
+	// Shrinks the map <m> to the smallest capacity that holds its items
+	template <typename TKey, typename TValue, typename THash> void shrinkToFit(HashMap<TKey, TValue, THash>& m);
+
+	// Debug function to check how well the hash of the keys spreads on real data
+	// Counts the items of the map <m> by probe length, the number of slots between an item and its home slot
+	// <histogram>[i] receives the count for length i, the last of the <count> entries also counts all longer lengths
+	// Returns the longest probe length
+	template <typename TKey, typename TValue, typename THash> uint32_t getProbeLengthHistogram(const HashMap<TKey, TValue, THash>& m, uint32_t* histogram, uint32_t count);
+
 } // namespace HashMapFn
 
 namespace HashMapInternalFn
 {
 	const uint32_t END_OF_LIST = 0xffffffffu;
-	const uint32_t DELETED = 0x80000000u;
 	const uint32_t FREE = 0x00000000u;
+	const uint32_t BATCH_SIZE = 16; // Lookups in flight in getBatch()
 
 	template <typename TKey, typename THash>
 	inline uint32_t getHashKey(const TKey& key)
@@ -48,12 +74,6 @@ namespace HashMapInternalFn
 		return hash(key); // uses Hash templates from Core/Functional.h
 	}
 
-	inline bool getIsDeleted(uint32_t index)
-	{
-		// MSB set indicates that this hash is a "tombstone"
-		return (index >> 31) != 0;
-	}
-
 	template <typename TKey, typename TValue, typename THash>
 	inline uint32_t getProbeDistance(const HashMap<TKey, TValue, THash>& m, uint32_t hash, uint32_t slotIndex)
 	{
@@ -62,14 +82,13 @@ namespace HashMapInternalFn
 	}
 
 	template <typename TKey, typename TValue, typename THash>
-	uint32_t find(const HashMap<TKey, TValue, THash>& m, const TKey& key)
+	uint32_t find(const HashMap<TKey, TValue, THash>& m, const TKey& key, uint32_t hash)
 	{
 		if (m.size == 0)
 		{
 			return END_OF_LIST;
 		}
 
-		const uint32_t hash = getHashKey<TKey, THash>(key);
 		uint32_t hashI = hash & m.mask;
 		uint32_t dist = 0;
 		for(;;)
@@ -82,9 +101,7 @@ namespace HashMapInternalFn
 			{
 				return END_OF_LIST;
 			}
-			else if (!getIsDeleted(m.index[hashI].index)
-				&& m.index[hashI].hash == hash
-				&& m.data[hashI].first == key)
+			else if (m.index[hashI].hash == hash && m.data[hashI].first == key)
 			{
 				return hashI;
 			}
@@ -94,6 +111,17 @@ namespace HashMapInternalFn
 		}
 	}
 
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t find(const HashMap<TKey, TValue, THash>& m, const TKey& key)
+	{
+		if (m.size == 0)
+		{
+			return END_OF_LIST;
+		}
+
+		return find(m, key, getHashKey<TKey, THash>(key));
+	}
+
 	template <typename TKey, typename TValue, typename THash>
 	void insert(HashMap<TKey, TValue, THash>& m, uint32_t hash, const TKey& key, const TValue& value)
 	{
@@ -113,13 +141,8 @@ namespace HashMapInternalFn
 			// If the existing element has probed less than us, then swap places with existing elem, 
 			// and keep looking for another slot for that element
 			uint32_t existingElementProbeDist = getProbeDistance(m, m.index[hashI].hash, hashI);
-			if (getIsDeleted(m.index[hashI].index) || existingElementProbeDist < dist)
+			if (existingElementProbeDist < dist)
 			{
-				if (getIsDeleted(m.index[hashI].index))
-				{
-					goto INSERT_AND_RETURN;
-				}
-
 				std::swap(hash, m.index[hashI].hash);
 				m.index[hashI].index = 0x0123abcd;
 				swap(newItem, m.data[hashI]);
@@ -167,7 +190,7 @@ namespace HashMapInternalFn
 			const uint32_t hash = m.index[i].hash;
 			const uint32_t index = m.index[i].index;
 
-			if (index != FREE && !getIsDeleted(index))
+			if (index != FREE)
 			{
 				HashMapInternalFn::insert(nm, hash, e.first, e.second);
 			}
@@ -192,6 +215,38 @@ namespace HashMapInternalFn
 		return m.size >= m.capacity * 0.9f;
 	}
 
+	// Returns the smallest capacity which holds <size> items without being full
+	inline uint32_t getCapacityFor(uint32_t size)
+	{
+		uint32_t capacity = 16;
+		while (size >= capacity * 0.9f)
+		{
+			capacity *= 2;
+		}
+		return capacity;
+	}
+
+	// Removes the item at slot <i> with backward shift deletion
+	// The items after it are moved back one slot until one is free or already in its home slot,
+	// so no tombstones are left behind and probe lengths do not grow with churn
+	template <typename TKey, typename TValue, typename THash>
+	void removeAt(HashMap<TKey, TValue, THash>& m, uint32_t i)
+	{
+		m.data[i].~Pair();
+
+		uint32_t next = (i + 1) & m.mask;
+		while (m.index[next].index != FREE && getProbeDistance(m, m.index[next].hash, next) != 0)
+		{
+			memcpy((void*)(m.data + i), (void*)(m.data + next), sizeof(m.data[i]));
+			m.index[i] = m.index[next];
+			i = next;
+			next = (next + 1) & m.mask;
+		}
+
+		m.index[i].hash = 0;
+		m.index[i].index = FREE;
+	}
+
 } // namespace HashMapInternalFn
 
 namespace HashMapFn
@@ -228,6 +283,41 @@ namespace HashMapFn
 		}
 	}
 
+	template <typename TKey, typename TValue, typename THash>
+	void getBatch(const HashMap<TKey, TValue, THash>& m, const TKey* keyList, uint32_t count, TValue* valueList, const TValue& deffault)
+	{
+		using namespace HashMapInternalFn;
+
+		if (m.size == 0)
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				valueList[i] = deffault;
+			}
+			return;
+		}
+
+		uint32_t hashList[BATCH_SIZE];
+		for (uint32_t first = 0; first < count; first += BATCH_SIZE)
+		{
+			const uint32_t batchCount = (count - first < BATCH_SIZE) ? count - first : BATCH_SIZE;
+
+			for (uint32_t i = 0; i < batchCount; ++i)
+			{
+				hashList[i] = getHashKey<TKey, THash>(keyList[first + i]);
+				const uint32_t hashI = hashList[i] & m.mask;
+				RIO_PREFETCH(m.index + hashI);
+				RIO_PREFETCH(m.data + hashI);
+			}
+
+			for (uint32_t i = 0; i < batchCount; ++i)
+			{
+				const uint32_t slot = find(m, keyList[first + i], hashList[i]);
+				valueList[first + i] = (slot == END_OF_LIST) ? deffault : m.data[slot].second;
+			}
+		}
+	}
+
 	template <typename TKey, typename TValue, typename THash>
 	void set(HashMap<TKey, TValue, THash>& m, const TKey& key, const TValue& value)
 	{
@@ -262,8 +352,7 @@ namespace HashMapFn
 			return;
 		}
 
-		m.data[i].~Pair();
-		m.index[i].index |= HashMapInternalFn::DELETED;
+		HashMapInternalFn::removeAt(m, i);
 		--m.size;
 	}
 
@@ -282,6 +371,63 @@ namespace HashMapFn
 		m.size = 0;
 	}
 
+	template <typename TKey, typename TValue, typename THash>
+	const typename HashMap<TKey, TValue, THash>::Entry* begin(const HashMap<TKey, TValue, THash>& m)
+	{
+		return m.data;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	const typename HashMap<TKey, TValue, THash>::Entry* end(const HashMap<TKey, TValue, THash>& m)
+	{
+		return m.data + m.capacity;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	bool getIsHole(const HashMap<TKey, TValue, THash>& m, const typename HashMap<TKey, TValue, THash>::Entry* entry)
+	{
+		return m.index[entry - m.data].index == HashMapInternalFn::FREE;
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void reserve(HashMap<TKey, TValue, THash>& m, uint32_t size)
+	{
+		const uint32_t capacity = HashMapInternalFn::getCapacityFor(size);
+		if (capacity > m.capacity)
+		{
+			HashMapInternalFn::rehash(m, capacity);
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	void shrinkToFit(HashMap<TKey, TValue, THash>& m)
+	{
+		const uint32_t capacity = HashMapInternalFn::getCapacityFor(m.size);
+		if (capacity < m.capacity)
+		{
+			HashMapInternalFn::rehash(m, capacity);
+		}
+	}
+
+	template <typename TKey, typename TValue, typename THash>
+	uint32_t getProbeLengthHistogram(const HashMap<TKey, TValue, THash>& m, uint32_t* histogram, uint32_t count)
+	{
+		memset(histogram, 0, count * sizeof(uint32_t));
+
+		uint32_t maxLength = 0;
+		for (uint32_t i = 0; i < m.capacity; ++i)
+		{
+			if (m.index[i].index != HashMapInternalFn::FREE)
+			{
+				const uint32_t length = HashMapInternalFn::getProbeDistance(m, m.index[i].hash, i);
+				++histogram[length < count ? length : count - 1];
+				maxLength = length > maxLength ? length : maxLength;
+			}
+		}
+
+		return maxLength;
+	}
+
 } // namespace HashMapFn
 
 template <typename TKey, typename TValue, typename THash>
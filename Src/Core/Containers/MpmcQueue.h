@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Core/Containers/Types.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+
+namespace MpmcQueueFn
+{
+	// Appends a copy of <item> to the queue <q>
+	// Returns false if the queue is full
+	template <typename T, uint32_t CAPACITY> bool push(MpmcQueue<T, CAPACITY>& q, const T& item);
+
+	// Removes the first item from the queue <q> and copies it to <item>
+	// Returns false if the queue is empty
+	template <typename T, uint32_t CAPACITY> bool pop(MpmcQueue<T, CAPACITY>& q, T& item);
+
+	// Returns the number of items in the queue <q>
+	// The value may already be stale when other threads are pushing or popping
+	template <typename T, uint32_t CAPACITY> uint32_t getCount(const MpmcQueue<T, CAPACITY>& q);
+
+} // namespace MpmcQueueFn
+
+namespace MpmcQueueFn
+{
+	template <typename T, uint32_t CAPACITY>
+	inline bool push(MpmcQueue<T, CAPACITY>& q, const T& item)
+	{
+		uint32_t tail = AtomicFn::loadRelaxed(&q.tail);
+
+		while (true)
+		{
+			typename MpmcQueue<T, CAPACITY>::Cell& cell = q.cellList[tail & (CAPACITY - 1)];
+			const int32_t difference = int32_t(AtomicFn::loadAcquire(&cell.sequence) - tail);
+
+			if (difference == 0)
+			{
+				// The cell is free for this position, claim it
+				if (AtomicFn::compareAndSwap(&q.tail, tail, tail + 1))
+				{
+					cell.item = item;
+					AtomicFn::storeRelease(&cell.sequence, tail + 1);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The cell still holds the item pushed one lap ago
+				return false;
+			}
+			else
+			{
+				// Another producer claimed the position
+				tail = AtomicFn::loadRelaxed(&q.tail);
+			}
+		}
+	}
+
+	template <typename T, uint32_t CAPACITY>
+	inline bool pop(MpmcQueue<T, CAPACITY>& q, T& item)
+	{
+		uint32_t head = AtomicFn::loadRelaxed(&q.head);
+
+		while (true)
+		{
+			typename MpmcQueue<T, CAPACITY>::Cell& cell = q.cellList[head & (CAPACITY - 1)];
+			const int32_t difference = int32_t(AtomicFn::loadAcquire(&cell.sequence) - (head + 1));
+
+			if (difference == 0)
+			{
+				// The cell holds the item for this position, claim it
+				if (AtomicFn::compareAndSwap(&q.head, head, head + 1))
+				{
+					item = cell.item;
+					// Free the cell for the push one lap ahead
+					AtomicFn::storeRelease(&cell.sequence, head + CAPACITY);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				// Nothing has been pushed at this position yet
+				return false;
+			}
+			else
+			{
+				// Another consumer claimed the position
+				head = AtomicFn::loadRelaxed(&q.head);
+			}
+		}
+	}
+
+	template <typename T, uint32_t CAPACITY>
+	inline uint32_t getCount(const MpmcQueue<T, CAPACITY>& q)
+	{
+		const uint32_t head = AtomicFn::loadAcquire(&q.head);
+		const uint32_t tail = AtomicFn::loadAcquire(&q.tail);
+		return int32_t(tail - head) > 0 ? tail - head : 0;
+	}
+
+} // namespace MpmcQueueFn
+
+template <typename T, uint32_t CAPACITY>
+inline MpmcQueue<T, CAPACITY>::MpmcQueue()
+{
+	for (uint32_t i = 0; i < CAPACITY; ++i)
+	{
+		cellList[i].sequence = i;
+	}
+}
+
+} // namespace Rio
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/Allocator.h"
+
+namespace Rio
+{
+
+// Allocator of a SmallArray
+// Hands out the inline buffer to the first request which fits in it and forwards the others to <backingAllocator>
+template <typename T, uint32_t N>
+struct SmallArrayAllocator : public Allocator
+{
+	alignas(T) char buffer[sizeof(T) * N];
+	Allocator* backingAllocator = nullptr;
+	bool isBufferUsed = false;
+
+	SmallArrayAllocator(Allocator& backingAllocator)
+		: backingAllocator(&backingAllocator)
+	{
+	}
+
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN)
+	{
+		if (!this->isBufferUsed && size <= sizeof(this->buffer) && align <= alignof(T))
+		{
+			this->isBufferUsed = true;
+			return this->buffer;
+		}
+
+		return this->backingAllocator->allocate(size, align);
+	}
+
+	void deallocate(void* data)
+	{
+		if (data == this->buffer)
+		{
+			this->isBufferUsed = false;
+			return;
+		}
+
+		this->backingAllocator->deallocate(data);
+	}
+
+	uint32_t getAllocatedSize(const void* ptr)
+	{
+		return ptr == this->buffer ? sizeof(this->buffer) : this->backingAllocator->getAllocatedSize(ptr);
+	}
+
+	uint32_t getTotalAllocatedBytes()
+	{
+		return SIZE_NOT_TRACKED;
+	}
+};
+
+// Dynamic array of POD items which keeps the first N items inline
+// The allocator is used only when the array grows beyond N items
+// Works with all the ArrayFn functions and can be passed wherever an Array<T> is expected
+template <typename T, uint32_t N>
+struct SmallArray : private SmallArrayAllocator<T, N>, public Array<T>
+{
+	NOT_TRIVIALLY_RELOCATABLE; // The items may live in the object itself
+
+	SmallArray(Allocator& a);
+	SmallArray(const SmallArray<T, N>& other);
+	SmallArray<T, N>& operator=(const SmallArray<T, N>& other);
+
+	// Returns whether the items are still in the inline buffer
+	bool getIsInline() const;
+};
+
+template <typename T, uint32_t N>
+inline SmallArray<T, N>::SmallArray(Allocator& a)
+	: SmallArrayAllocator<T, N>(a)
+	, Array<T>(static_cast<SmallArrayAllocator<T, N>&>(*this))
+{
+	// Start with the whole inline buffer, so the array does not grow through it one step at a time
+	this->data = (T*)SmallArrayAllocator<T, N>::allocate(sizeof(T) * N, alignof(T));
+	this->capacity = N;
+}
+
+template <typename T, uint32_t N>
+inline SmallArray<T, N>::SmallArray(const SmallArray<T, N>& other)
+	: SmallArray<T, N>(*other.backingAllocator)
+{
+	ArrayFn::push(*this, other.data, other.size);
+}
+
+template <typename T, uint32_t N>
+inline SmallArray<T, N>& SmallArray<T, N>::operator=(const SmallArray<T, N>& other)
+{
+	Array<T>::operator=(other);
+	return *this;
+}
+
+template <typename T, uint32_t N>
+inline bool SmallArray<T, N>::getIsInline() const
+{
+	return (const char*)this->data == this->buffer;
+}
+
+} // namespace Rio
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Core/Containers/Types.h"
+#include "Core/Error/Error.h"
+#include "Core/Memory/Allocator.h"
+
+#include <cstring> // memcpy
+
+namespace Rio
+{
+
+namespace SoaBufferInternalFn
+{
+	// Type of the column <I> of a SoaBuffer<Ts...>
+	template <uint32_t I, typename T, typename... Ts>
+	struct ColumnType
+	{
+		using Type = typename ColumnType<I - 1, Ts...>::Type;
+	};
+
+	template <typename T, typename... Ts>
+	struct ColumnType<0, T, Ts...>
+	{
+		using Type = T;
+	};
+
+} // namespace SoaBufferInternalFn
+
+namespace SoaBufferFn
+{
+	// Returns the number of rows in the buffer <b>
+	template <typename... Ts> uint32_t getCount(const SoaBuffer<Ts...>& b);
+
+	// Returns the column <I> of the buffer <b>
+	// The pointer is invalidated when the buffer grows
+	template <uint32_t I, typename... Ts> typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* getColumn(SoaBuffer<Ts...>& b);
+	template <uint32_t I, typename... Ts> const typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* getColumn(const SoaBuffer<Ts...>& b);
+
+	// Returns a pointer to the first item of the column <I> of the buffer <b>
+	template <uint32_t I, typename... Ts> typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* begin(SoaBuffer<Ts...>& b);
+
+	// Returns a pointer past the last item of the column <I> of the buffer <b>
+	template <uint32_t I, typename... Ts> typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* end(SoaBuffer<Ts...>& b);
+
+	// Points <columnList>, one pointer per column, to the columns of the buffer <b>
+	// The pointers are kept up to date whenever the buffer moves its columns, they must outlive the buffer
+	template <typename... Ts> void bind(SoaBuffer<Ts...>& b, Ts*&... columnList);
+
+	// Resizes the columns of the buffer <b> to hold <capacity> rows
+	// Rows past <capacity> are dropped
+	template <typename... Ts> void setCapacity(SoaBuffer<Ts...>& b, uint32_t capacity);
+
+	// Reserves space in the buffer <b> for at least <capacity> rows
+	template <typename... Ts> void reserve(SoaBuffer<Ts...>& b, uint32_t capacity);
+
+	// Grows the buffer <b> to contain at least <minCapacity> rows
+	template <typename... Ts> void grow(SoaBuffer<Ts...>& b, uint32_t minCapacity);
+
+	// Appends a row to the buffer <b> and returns its index
+	// The items of the new row are left uninitialized
+	template <typename... Ts> uint32_t pushBack(SoaBuffer<Ts...>& b);
+
+	// Removes the row <index> from the buffer <b> by moving the last row in its place
+	template <typename... Ts> void swapRemove(SoaBuffer<Ts...>& b, uint32_t index);
+
+	// Removes all the rows from the buffer <b>
+	// Does not free memory
+	template <typename... Ts> void clear(SoaBuffer<Ts...>& b);
+
+} // namespace SoaBufferFn
+
+namespace SoaBufferInternalFn
+{
+	// Fills <offsetList> with the offset of every column of <capacity> rows from the start of the buffer
+	// Returns the size of the buffer in bytes
+	inline uint32_t getLayout(uint32_t capacity, const uint32_t* sizeList, const uint32_t* alignList, uint32_t columnCount, uint32_t* offsetList)
+	{
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < columnCount; ++i)
+		{
+			const uint32_t align = alignList[i] > RIO_CACHE_LINE_SIZE ? alignList[i] : RIO_CACHE_LINE_SIZE;
+			offset = (offset + align - 1) / align * align;
+			offsetList[i] = offset;
+			offset += capacity * sizeList[i];
+		}
+
+		return offset;
+	}
+
+} // namespace SoaBufferInternalFn
+
+namespace SoaBufferFn
+{
+	template <typename... Ts>
+	inline uint32_t getCount(const SoaBuffer<Ts...>& b)
+	{
+		return b.size;
+	}
+
+	template <uint32_t I, typename... Ts>
+	inline typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* getColumn(SoaBuffer<Ts...>& b)
+	{
+		RIO_STATIC_ASSERT(I < sizeof...(Ts), "Column out of bounds");
+		return (typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type*)b.columnList[I];
+	}
+
+	template <uint32_t I, typename... Ts>
+	inline const typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* getColumn(const SoaBuffer<Ts...>& b)
+	{
+		RIO_STATIC_ASSERT(I < sizeof...(Ts), "Column out of bounds");
+		return (const typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type*)b.columnList[I];
+	}
+
+	template <uint32_t I, typename... Ts>
+	inline typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* begin(SoaBuffer<Ts...>& b)
+	{
+		return getColumn<I>(b);
+	}
+
+	template <uint32_t I, typename... Ts>
+	inline typename SoaBufferInternalFn::ColumnType<I, Ts...>::Type* end(SoaBuffer<Ts...>& b)
+	{
+		return getColumn<I>(b) + b.size;
+	}
+
+	template <typename... Ts>
+	inline void bind(SoaBuffer<Ts...>& b, Ts*&... columnList)
+	{
+		void** bindingList[] = { (void**)&columnList... };
+		for (uint32_t i = 0; i < sizeof...(Ts); ++i)
+		{
+			b.bindingList[i] = bindingList[i];
+			*bindingList[i] = b.columnList[i];
+		}
+	}
+
+	template <typename... Ts>
+	inline void setCapacity(SoaBuffer<Ts...>& b, uint32_t capacity)
+	{
+		if (capacity == b.capacity)
+		{
+			return;
+		}
+
+		if (capacity < b.size)
+		{
+			b.size = capacity;
+		}
+
+		const uint32_t sizeList[] = { (uint32_t)sizeof(Ts)... };
+		const uint32_t alignList[] = { (uint32_t)alignof(Ts)... };
+		uint32_t offsetList[sizeof...(Ts)];
+		const uint32_t bytes = SoaBufferInternalFn::getLayout(capacity, sizeList, alignList, sizeof...(Ts), offsetList);
+
+		char* buffer = nullptr;
+		if (capacity > 0)
+		{
+			buffer = (char*)b.allocator->allocate(bytes, RIO_CACHE_LINE_SIZE);
+		}
+
+		for (uint32_t i = 0; i < sizeof...(Ts); ++i)
+		{
+			void* column = capacity > 0 ? buffer + offsetList[i] : nullptr;
+			if (b.size > 0)
+			{
+				memcpy(column, b.columnList[i], b.size * sizeList[i]);
+			}
+
+			b.columnList[i] = column;
+			if (b.bindingList[i] != nullptr)
+			{
+				*b.bindingList[i] = column;
+			}
+		}
+
+		b.allocator->deallocate(b.buffer);
+		b.buffer = buffer;
+		b.capacity = capacity;
+	}
+
+	template <typename... Ts>
+	inline void reserve(SoaBuffer<Ts...>& b, uint32_t capacity)
+	{
+		if (capacity > b.capacity)
+		{
+			setCapacity(b, capacity);
+		}
+	}
+
+	template <typename... Ts>
+	inline void grow(SoaBuffer<Ts...>& b, uint32_t minCapacity)
+	{
+		uint32_t newCapacity = b.capacity * 2 + 1;
+
+		if (newCapacity < minCapacity)
+		{
+			newCapacity = minCapacity;
+		}
+
+		setCapacity(b, newCapacity);
+	}
+
+	template <typename... Ts>
+	inline uint32_t pushBack(SoaBuffer<Ts...>& b)
+	{
+		if (b.size == b.capacity)
+		{
+			grow(b, 0);
+		}
+
+		return b.size++;
+	}
+
+	template <typename... Ts>
+	inline void swapRemove(SoaBuffer<Ts...>& b, uint32_t index)
+	{
+		RIO_ASSERT(index < b.size, "Index out of bounds");
+
+		const uint32_t lastIndex = b.size - 1;
+		if (index != lastIndex)
+		{
+			const uint32_t sizeList[] = { (uint32_t)sizeof(Ts)... };
+			for (uint32_t i = 0; i < sizeof...(Ts); ++i)
+			{
+				char* column = (char*)b.columnList[i];
+				memcpy(column + index * sizeList[i], column + lastIndex * sizeList[i], sizeList[i]);
+			}
+		}
+
+		--b.size;
+	}
+
+	template <typename... Ts>
+	inline void clear(SoaBuffer<Ts...>& b)
+	{
+		b.size = 0;
+	}
+
+} // namespace SoaBufferFn
+
+template <typename... Ts>
+inline SoaBuffer<Ts...>::SoaBuffer(Allocator& a)
+	: allocator(&a)
+{
+}
+
+template <typename... Ts>
+inline SoaBuffer<Ts...>::~SoaBuffer()
+{
+	this->allocator->deallocate(this->buffer);
+}
+
+} // namespace Rio
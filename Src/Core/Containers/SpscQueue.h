@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Core/Containers/Types.h"
+#include "Core/Thread/Atomic.h"
+
+namespace Rio
+{
+
+namespace SpscQueueFn
+{
+	// Appends a copy of <item> to the queue <q>
+	// Returns false if the queue is full
+	// Must be called by the producer thread only
+	template <typename T, uint32_t CAPACITY> bool push(SpscQueue<T, CAPACITY>& q, const T& item);
+
+	// Removes the first item from the queue <q> and copies it to <item>
+	// Returns false if the queue is empty
+	// Must be called by the consumer thread only
+	template <typename T, uint32_t CAPACITY> bool pop(SpscQueue<T, CAPACITY>& q, T& item);
+
+	// Returns the number of items in the queue <q>
+	// The value may already be stale when other threads are pushing or popping
+	template <typename T, uint32_t CAPACITY> uint32_t getCount(const SpscQueue<T, CAPACITY>& q);
+
+	// Returns whether the queue <q> is empty
+	// The value may already be stale when other threads are pushing or popping
+	template <typename T, uint32_t CAPACITY> bool getIsEmpty(const SpscQueue<T, CAPACITY>& q);
+
+} // namespace SpscQueueFn
+
+namespace SpscQueueFn
+{
+	template <typename T, uint32_t CAPACITY>
+	inline bool push(SpscQueue<T, CAPACITY>& q, const T& item)
+	{
+		const uint32_t tail = q.tail;
+
+		if (tail - q.cachedHead == CAPACITY)
+		{
+			q.cachedHead = AtomicFn::loadAcquire(&q.head);
+			if (tail - q.cachedHead == CAPACITY)
+			{
+				return false;
+			}
+		}
+
+		q.data[tail & (CAPACITY - 1)] = item;
+		AtomicFn::storeRelease(&q.tail, tail + 1);
+		return true;
+	}
+
+	template <typename T, uint32_t CAPACITY>
+	inline bool pop(SpscQueue<T, CAPACITY>& q, T& item)
+	{
+		const uint32_t head = q.head;
+
+		if (head == q.cachedTail)
+		{
+			q.cachedTail = AtomicFn::loadAcquire(&q.tail);
+			if (head == q.cachedTail)
+			{
+				return false;
+			}
+		}
+
+		item = q.data[head & (CAPACITY - 1)];
+		AtomicFn::storeRelease(&q.head, head + 1);
+		return true;
+	}
+
+	template <typename T, uint32_t CAPACITY>
+	inline uint32_t getCount(const SpscQueue<T, CAPACITY>& q)
+	{
+		const uint32_t head = AtomicFn::loadAcquire(&q.head);
+		return AtomicFn::loadAcquire(&q.tail) - head;
+	}
+
+	template <typename T, uint32_t CAPACITY>
+	inline bool getIsEmpty(const SpscQueue<T, CAPACITY>& q)
+	{
+		return getCount(q) == 0;
+	}
+
+} // namespace SpscQueueFn
+
+} // namespace Rio
@@ -3,6 +3,7 @@
 #include "Core/Functional.h"
 #include "Core/Memory/Types.h"
 #include "Core/Pair.h"
+#include "Core/Platform.h"
 #include "Core/Types.h"
 
 namespace Rio
@@ -14,6 +15,7 @@ template <typename T>
 struct Array
 {
 	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
 
 	Allocator* allocator = nullptr;
 	uint32_t capacity = 0;
@@ -37,6 +39,7 @@ template <typename T>
 struct Vector
 {
 	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
 
 	Allocator* allocator = nullptr;
 	uint32_t capacity = 0;
@@ -56,6 +59,7 @@ template <typename T>
 struct Queue
 {
 	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
 
 	uint32_t read = 0;
 	uint32_t size = 0;
@@ -66,16 +70,84 @@ struct Queue
 	const T& operator[](uint32_t index) const;
 };
 
+// Rows of POD items stored as one column per type (structure of arrays) in a single allocation
+// Every column starts on its own cache line, so a loop over one column never pulls in the others
+// Pointers bound with SoaBufferFn::bind() are moved along with the columns when the buffer grows
+template <typename... Ts>
+struct SoaBuffer
+{
+	ALLOCATOR_AWARE;
+
+	static const uint32_t COLUMN_COUNT = sizeof...(Ts);
+	RIO_STATIC_ASSERT(COLUMN_COUNT > 0, "SoaBuffer needs at least one column");
+
+	Allocator* allocator = nullptr;
+	uint32_t capacity = 0;
+	uint32_t size = 0;
+	void* buffer = nullptr;
+	void* columnList[COLUMN_COUNT] = {};
+	void** bindingList[COLUMN_COUNT] = {};
+
+	SoaBuffer(Allocator& a);
+	SoaBuffer(const SoaBuffer<Ts...>&) = delete;
+	~SoaBuffer();
+	SoaBuffer<Ts...>& operator=(const SoaBuffer<Ts...>&) = delete;
+};
+
+// Bounded lock-free ring of POD items for one producer thread and one consumer thread
+// <head> and <tail> count items ever popped and pushed, each one on its own cache line
+// Each side keeps a copy of the other side's index and reads the shared one only when the copy says empty or full
+template <typename T, uint32_t CAPACITY>
+struct SpscQueue
+{
+	RIO_STATIC_ASSERT((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+	char padding0[RIO_CACHE_LINE_SIZE];
+	uint32_t head = 0; // Written by the consumer
+	uint32_t cachedTail = 0; // Consumer only
+	char padding1[RIO_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
+	uint32_t tail = 0; // Written by the producer
+	uint32_t cachedHead = 0; // Producer only
+	char padding2[RIO_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
+	T data[CAPACITY];
+};
+
+// Bounded lock-free ring of POD items for any number of producer and consumer threads
+// Every cell carries a sequence number telling whether it is ready to be pushed or popped at a given position,
+// producers and consumers claim positions with a compare and swap on <tail> and <head>
+template <typename T, uint32_t CAPACITY>
+struct MpmcQueue
+{
+	RIO_STATIC_ASSERT((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+	struct Cell
+	{
+		uint32_t sequence;
+		T item;
+	};
+
+	char padding0[RIO_CACHE_LINE_SIZE];
+	uint32_t tail = 0;
+	char padding1[RIO_CACHE_LINE_SIZE - sizeof(uint32_t)];
+	uint32_t head = 0;
+	char padding2[RIO_CACHE_LINE_SIZE - sizeof(uint32_t)];
+	Cell cellList[CAPACITY];
+
+	MpmcQueue();
+};
+
 // Map from key to value
 // Uses a Vector internally, so not suited for performance-critical stuff
 template <typename TKey, typename TValue>
 struct Map
 {
 	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
 
 	struct Node
 	{
 		ALLOCATOR_AWARE;
+		typedef Int2Type<IS_TRIVIALLY_RELOCATABLE(TKey) && IS_TRIVIALLY_RELOCATABLE(TValue)> triviallyRelocatableMarker;
 
 		PAIR(TKey, TValue) pair;
 		uint32_t left = 0;
@@ -101,6 +173,7 @@ template <typename TKey, typename TValue, typename THash = Hash<TKey>>
 struct HashMap
 {
 	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
 
 	using Entry = PAIR(TKey, TValue);
 
@@ -122,6 +195,31 @@ struct HashMap
 	const TValue& operator[](const TKey& key) const;
 };
 
+// Open addressing hash map with a 1-byte control tag per slot
+// Lookups compare the tags of a whole group of slots at once (with SSE2 when available)
+// and only compare keys on a tag match
+// Uses the same HashMapFn functions as HashMap
+template <typename TKey, typename TValue, typename THash = Hash<TKey>>
+struct FlatHashMap
+{
+	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
+
+	using Entry = PAIR(TKey, TValue);
+
+	Allocator* allocator = nullptr;
+	uint32_t capacity = 0; // Power of two, at least one group
+	uint32_t size = 0;
+	uint32_t deletedCount = 0;
+	uint32_t groupMask = 0;
+	uint8_t* controlList = nullptr;
+	Entry* data = nullptr;
+
+	FlatHashMap(Allocator& a);
+	~FlatHashMap();
+	const TValue& operator[](const TKey& key) const;
+};
+
 // Vector of sorted items
 // Items are not automatically sorted, 
 // Need to call SortMapFn::sort() whenever you are done inserting/removing items
@@ -129,6 +227,7 @@ template <typename TKey, typename TValue, typename Compare = Less<TKey>>
 struct SortMap
 {
 	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
 
 	using Entry = PAIR(TKey, TValue);
 
@@ -3,6 +3,7 @@
 #include "Core/Containers/Types.h"
 #include "Core/Error/Error.h"
 #include "Core/Memory/Allocator.h"
+#include "Core/Memory/Memory.h"
 
 namespace Rio
 {
@@ -26,6 +27,8 @@ namespace VectorFn
 	// Reserves space in the vector <v> for at least <capacity> items
 	template <typename T> void reserve(Vector<T>& v, uint32_t capacity);
 
+	// Sets the capacity of the vector <v>
+	// Items are moved to the new memory with memcpy if T is trivially relocatable, or else with their move constructor
 	template <typename T> void setCapacity(Vector<T>& v, uint32_t capacity);
 
 	// Grows the vector <v> to contain at least <minCapacity> items
@@ -73,6 +76,39 @@ namespace VectorFn
 
 } // namespace VectorFn
 
+namespace VectorInternalFn
+{
+	// Move constructs the <count> items at <source> into <destination> and destroys the originals
+	// Types without a move constructor are copied
+	template <typename T>
+	inline void relocate(T* destination, T* source, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			new (destination + i) T(static_cast<T&&>(source[i]));
+			source[i].~T();
+		}
+	}
+
+	// Moves the items of <v> to a new block of <capacity> items
+	// The allocator may be able to extend the block without moving the items at all
+	template <typename T>
+	inline void setData(Vector<T>& v, uint32_t capacity, Int2Type<true>)
+	{
+		v.data = (T*)v.allocator->reallocate(v.data, v.size * sizeof(T), capacity * sizeof(T), alignof(T));
+	}
+
+	template <typename T>
+	inline void setData(Vector<T>& v, uint32_t capacity, Int2Type<false>)
+	{
+		T* tmp = v.data;
+		v.data = (T*)v.allocator->allocate(capacity * sizeof(T), alignof(T));
+		relocate(v.data, tmp, v.size);
+		v.allocator->deallocate(tmp);
+	}
+
+} // namespace VectorInternalFn
+
 namespace VectorFn
 {
 	template <typename T>
@@ -128,21 +164,8 @@ namespace VectorFn
 
 		if (capacity > 0)
 		{
-			T* tmp = v.data;
+			VectorInternalFn::setData(v, capacity, Int2Type<IS_TRIVIALLY_RELOCATABLE(T)>());
 			v.capacity = capacity;
-			v.data = (T*)v.allocator->allocate(capacity * sizeof(T), alignof(T));
-
-			for (uint32_t i = 0; i < v.size; ++i)
-			{
-				new (v.data + i) T(tmp[i]);
-			}
-
-			for (uint32_t i = 0; i < v.size; ++i)
-			{
-				tmp[i].~T();
-			}
-
-			v.allocator->deallocate(tmp);
 		}
 	}
 
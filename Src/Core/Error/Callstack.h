@@ -10,6 +10,13 @@ namespace ErrorFn
 	// Fills stringStream with the current call stack
 	void callstack(StringStream& stringStream);
 
+	// Stores up to <maxCount> return addresses of the current call stack in <frameList>, skipping the innermost <skipCount> frames
+	// Returns the number of addresses stored, cheap enough to be called on every allocation
+	uint32_t captureFrameList(void** frameList, uint32_t maxCount, uint32_t skipCount);
+
+	// Fills stringStream with the symbols of the <count> addresses in <frameList>
+	void writeFrameList(StringStream& stringStream, void* const* frameList, uint32_t count);
+
 } // namespace ErrorFn
 
 } // namespace Rio
@@ -14,6 +14,16 @@ namespace ErrorFn
 		stringStream << "Not supported";
 	}
 
+	uint32_t captureFrameList(void** /*frameList*/, uint32_t /*maxCount*/, uint32_t /*skipCount*/)
+	{
+		return 0;
+	}
+
+	void writeFrameList(StringStream& stringStream, void* const* /*frameList*/, uint32_t /*count*/)
+	{
+		stringStream << "Not supported";
+	}
+
 } // namespace ErrorFn
 
 } // namespace Rio
@@ -31,14 +31,12 @@ namespace ErrorFn
 		return "<addr2line missing>";
 	}
 
-	void callstack(StringStream& stringStream)
+	// Writes the symbols of frames [<first>, <size>) of <frameList> to <stringStream>
+	static void writeSymbols(StringStream& stringStream, void* const* frameList, int first, int size)
 	{
-		void* arrayTemp[64];
-		int size = backtrace(array, countof(arrayTemp));
-		char** messages = backtrace_symbols(arrayTemp, size);
+		char** messages = backtrace_symbols(frameList, size);
 
-		// skip first stack frame (points here)
-		for (int i = 1; i < size && messages != nullptr; ++i)
+		for (int i = first; i < size && messages != nullptr; ++i)
 		{
 			char* message = messages[i];
 			char* mangledName = strchr(message, '(');
@@ -85,6 +83,39 @@ namespace ErrorFn
 		free(messages);
 	}
 
+	void callstack(StringStream& stringStream)
+	{
+		void* arrayTemp[64];
+		int size = backtrace(arrayTemp, countof(arrayTemp));
+
+		// skip first stack frame (points here)
+		writeSymbols(stringStream, arrayTemp, 1, size);
+	}
+
+	uint32_t captureFrameList(void** frameList, uint32_t maxCount, uint32_t skipCount)
+	{
+		void* arrayTemp[64];
+		// Skip this function too
+		uint32_t wanted = maxCount + skipCount + 1;
+		if (wanted > countof(arrayTemp))
+		{
+			wanted = countof(arrayTemp);
+		}
+		const uint32_t size = (uint32_t)backtrace(arrayTemp, (int)wanted);
+
+		uint32_t count = 0;
+		for (uint32_t i = skipCount + 1; i < size; ++i)
+		{
+			frameList[count++] = arrayTemp[i];
+		}
+		return count;
+	}
+
+	void writeFrameList(StringStream& stringStream, void* const* frameList, uint32_t count)
+	{
+		writeSymbols(stringStream, frameList, 0, (int)count);
+	}
+
 } // namespace ErrorFn
 
 } // namespace Rio
@@ -107,6 +107,63 @@ namespace ErrorFn
 		SymCleanup(GetCurrentProcess());
 	}
 
+	uint32_t captureFrameList(void** frameList, uint32_t maxCount, uint32_t skipCount)
+	{
+		// Skip this function too
+		return (uint32_t)RtlCaptureStackBackTrace((DWORD)skipCount + 1, (DWORD)maxCount, frameList, NULL);
+	}
+
+	void writeFrameList(StringStream& stringStream, void* const* frameList, uint32_t count)
+	{
+		SymInitialize(GetCurrentProcess(), NULL, TRUE);
+		SymSetOptions(SYMOPT_LOAD_LINES | SYMOPT_UNDNAME);
+
+		DWORD ldsp = 0;
+		IMAGEHLP_LINE64 line;
+		ZeroMemory(&line, sizeof(IMAGEHLP_LINE64));
+		line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+
+		char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(TCHAR)];
+		PSYMBOL_INFO sym = (PSYMBOL_INFO)buffer;
+		sym->SizeOfStruct = sizeof(SYMBOL_INFO);
+		sym->MaxNameLen = MAX_SYM_NAME;
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const DWORD64 address = (DWORD64)frameList[i];
+
+			BOOL res = SymGetLineFromAddr64(GetCurrentProcess(), address, &ldsp, &line);
+			res = res && SymFromAddr(GetCurrentProcess(), address, 0, sym);
+
+			char outputBuffer[512];
+
+			if (res == TRUE)
+			{
+				Rio::snPrintF(outputBuffer
+					, sizeof(outputBuffer)
+					, "    [%2i] %s in %s:%d\n"
+					, i
+					, sym->Name
+					, line.FileName
+					, line.LineNumber
+					);
+			}
+			else
+			{
+				Rio::snPrintF(outputBuffer
+					, sizeof(outputBuffer)
+					, "    [%2i] 0x%p\n"
+					, i
+					, frameList[i]
+					);
+			}
+
+			stringStream << outputBuffer;
+		}
+
+		SymCleanup(GetCurrentProcess());
+	}
+
 } // namespace ErrorFn
 
 } // namespace Rio
@@ -41,7 +41,7 @@ struct FileDisk : public File
 	{
 #if RIO_PLATFORM_POSIX
 		this->file = fopen(path, (mode == FileOpenMode::READ) ? "rb" : "wb");
-		RIO_ASSERT(_file != NULL, "fopen: errno = %d, path = '%s'", errno, path);
+		RIO_ASSERT(this->file != NULL, "fopen: errno = %d, path = '%s'", errno, path);
 #elif RIO_PLATFORM_WINDOWS
 		this->file = CreateFile(path
 			, (mode == FileOpenMode::READ) ? GENERIC_READ : GENERIC_WRITE
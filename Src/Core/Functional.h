@@ -60,7 +60,56 @@ struct LessEqual
 	};
 };
 
+namespace HashFn
+{
+	// Finalizer of MurmurHash3, every output bit depends on every input bit
+	// Hash maps mask the hash with capacity - 1, so ids whose low bits alone do not spread well are mixed first
+	inline uint32_t mix(uint32_t value)
+	{
+		value ^= value >> 16;
+		value *= 0x85ebca6bu;
+		value ^= value >> 13;
+		value *= 0xc2b2ae35u;
+		value ^= value >> 16;
+		return value;
+	}
+
+	// Same as above, folding all the 64 bits of <value> into the result
+	inline uint32_t mix(uint64_t value)
+	{
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+		return (uint32_t)value;
+	}
+
+} // namespace HashFn
+
+// Marks a hash function whose result is already mixed, so hash maps use it as is instead of mixing it again
+#define HASH_IS_MIXED typedef bool isMixedMarker
+
+// Determines if a hash function is marked HASH_IS_MIXED
+template <typename THash>
+struct IsHashMixed
+{
+	template <typename C>
+	static char testFunction(typename C::isMixedMarker*);
+
+	template <typename C>
+	static int testFunction(...);
+
+	enum
+	{
+		value = sizeof(testFunction<THash>(0)) == sizeof(char)
+	};
+};
+
+#define IS_HASH_MIXED(THash) IsHashMixed<THash>::value
+
 // Hash functions
+// The integer ones are the identity, the others are marked HASH_IS_MIXED
 template <typename T>
 struct Hash;
 
@@ -148,6 +197,8 @@ struct Hash<uint64_t>
 template<>
 struct Hash<float>
 {
+	HASH_IS_MIXED;
+
 	uint32_t operator()(const float val) const
 	{
 		return val == 0.0f ? 0 : murmur32(&val, sizeof(val), 0);
@@ -157,6 +208,8 @@ struct Hash<float>
 template<>
 struct Hash<double>
 {
+	HASH_IS_MIXED;
+
 	uint32_t operator()(const double val) const
 	{
 		return val == 0.0 ? 0 : murmur32(&val, sizeof(val), 0);
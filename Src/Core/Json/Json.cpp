@@ -1,7 +1,7 @@
 #include "Core/Json/Json.h"
 
-#include "Core/Containers/Map.h"
-#include "Core/Memory/TempAllocator.h"
+#include "Core/Containers/SmallArray.h"
+#include "Core/Json/JsonObject.h"
 #include "Core/Strings/DynamicString.h"
 #include "Core/Strings/String.h"
 
@@ -75,8 +75,7 @@ namespace JsonFn
 	{
 		RIO_ENSURE(nullptr != json);
 
-		TempAllocator512 tempAllocator512;
-	 	Array<char> number(tempAllocator512);
+		SmallArray<char, 64> number(getDefaultScratchAllocator());
 
 		if (*json == '-')
 		{
@@ -254,20 +253,15 @@ namespace JsonFn
 
 			while (*json)
 			{
-				const char* keyBegin = *json == '"' ? (json + 1) : json;
-
-				TempAllocator256 ta;
-				DynamicString key(ta);
-				parseString(json, key);
-
-				FixedString keyStr(keyBegin, key.getLength());
-
+				// The key points into <json>, quotes excluded
+				const char* keyBegin = json + 1;
 				json = skipString(json);
+				FixedString keyStr(keyBegin, uint32_t(json - keyBegin) - 1);
 				json = skipSpaces(json);
 				json = skipExpectedToNext(json, ':');
 				json = skipSpaces(json);
 
-				MapFn::set(object.jsonMap, keyStr, json);
+				JsonObjectFn::set(object, keyStr, json);
 
 				json = skipValue(json);
 				json = skipSpaces(json);
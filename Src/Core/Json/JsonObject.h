@@ -1,7 +1,8 @@
 #pragma once
 
-#include "Core/Containers/Map.h"
+#include "Core/Containers/Array.h"
 #include "Core/Json/Types.h"
+#include "Core/Murmur.h"
 
 namespace Rio
 {
@@ -9,46 +10,175 @@ namespace Rio
 namespace JsonObjectFn
 {
 	// Returns the number of keys in the object <jsonObject>
+	uint32_t getSize(const JsonObject& jsonObject);
+
+	// Returns whether the object <jsonObject> has the <key>
+	bool has(const JsonObject& jsonObject, const char* key);
+
+	// Returns whether the object <jsonObject> has the <key>
+	bool has(const JsonObject& jsonObject, const FixedString& key);
+
+	// Sets the <value> of the <key> in the object <jsonObject>
+	// An existing <key> keeps its position in the iteration order
+	void set(JsonObject& jsonObject, const FixedString& key, const char* value);
+
+	// Removes all the keys from the object <jsonObject>
+	void clear(JsonObject& jsonObject);
+
+	// Returns a pointer to the first item in the object <jsonObject>
+	const JsonObject::Node* begin(const JsonObject& jsonObject);
+
+	// Returns a pointer to the item following the last item in the object <jsonObject>
+	const JsonObject::Node* end(const JsonObject& jsonObject);
+
+} // namespace JsonObjectFn
+
+namespace JsonObjectInternalFn
+{
+	const uint32_t END_OF_LIST = UINT32_MAX;
+	const uint32_t MIN_INDEX_CAPACITY = 16;
+
+	inline uint32_t getHash(const FixedString& key)
+	{
+		return murmur32(key.data, key.length, 0);
+	}
+
+	// Returns the slot in the index of <jsonObject> which holds the <key>, or the free slot where it would go
+	inline uint32_t findSlot(const JsonObject& jsonObject, const FixedString& key, uint32_t hash)
+	{
+		const uint32_t mask = ArrayFn::getCount(jsonObject.indexList) - 1;
+
+		for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask)
+		{
+			const uint32_t nodeIndex = jsonObject.indexList[slot];
+			if (nodeIndex == END_OF_LIST)
+			{
+				return slot;
+			}
+
+			const JsonObject::Node& node = jsonObject.nodeList[nodeIndex];
+			if (node.hash == hash && node.pair.first == key)
+			{
+				return slot;
+			}
+		}
+	}
+
+	// Returns the value of the <key> in <jsonObject> or nullptr
+	inline const char* get(const JsonObject& jsonObject, const FixedString& key)
+	{
+		if (ArrayFn::getCount(jsonObject.indexList) == 0)
+		{
+			return nullptr;
+		}
+
+		const uint32_t nodeIndex = jsonObject.indexList[findSlot(jsonObject, key, getHash(key))];
+		return nodeIndex == END_OF_LIST ? nullptr : jsonObject.nodeList[nodeIndex].pair.second;
+	}
+
+	// Rebuilds the index of <jsonObject> with <capacity> slots
+	inline void rehash(JsonObject& jsonObject, uint32_t capacity)
+	{
+		ArrayFn::resize(jsonObject.indexList, capacity);
+		memset(ArrayFn::begin(jsonObject.indexList), 0xff, sizeof(uint32_t) * capacity);
+
+		const uint32_t mask = capacity - 1;
+		for (uint32_t i = 0; i < ArrayFn::getCount(jsonObject.nodeList); ++i)
+		{
+			uint32_t slot = jsonObject.nodeList[i].hash & mask;
+			while (jsonObject.indexList[slot] != END_OF_LIST)
+			{
+				slot = (slot + 1) & mask;
+			}
+			jsonObject.indexList[slot] = i;
+		}
+	}
+
+} // namespace JsonObjectInternalFn
+
+namespace JsonObjectFn
+{
 	inline uint32_t getSize(const JsonObject& jsonObject)
 	{
-		return MapFn::getCount(jsonObject.jsonMap);
+		return ArrayFn::getCount(jsonObject.nodeList);
 	}
 
-	// Returns whether the object <jsonObject> has the <key>
 	inline bool has(const JsonObject& jsonObject, const char* key)
 	{
-		return MapFn::has(jsonObject.jsonMap, FixedString(key));
+		return has(jsonObject, FixedString(key));
 	}
 
-	// Returns a pointer to the first item in the object <jsonObject>
-	inline const Map<FixedString, const char*>::Node* begin(const JsonObject& jsonObject)
+	inline bool has(const JsonObject& jsonObject, const FixedString& key)
 	{
-		return MapFn::begin(jsonObject.jsonMap);
+		if (ArrayFn::getCount(jsonObject.indexList) == 0)
+		{
+			return false;
+		}
+
+		const uint32_t slot = JsonObjectInternalFn::findSlot(jsonObject, key, JsonObjectInternalFn::getHash(key));
+		return jsonObject.indexList[slot] != JsonObjectInternalFn::END_OF_LIST;
 	}
 
-	// Returns a pointer to the item following the last item in the object <jsonObject>
-	inline const Map<FixedString, const char*>::Node* end(const JsonObject& jsonObject)
+	inline void set(JsonObject& jsonObject, const FixedString& key, const char* value)
 	{
-		return MapFn::end(jsonObject.jsonMap);
+		// Keep the index at most half full
+		const uint32_t indexCapacity = ArrayFn::getCount(jsonObject.indexList);
+		if ((ArrayFn::getCount(jsonObject.nodeList) + 1) * 2 > indexCapacity)
+		{
+			JsonObjectInternalFn::rehash(jsonObject, indexCapacity == 0 ? JsonObjectInternalFn::MIN_INDEX_CAPACITY : indexCapacity * 2);
+		}
+
+		const uint32_t hash = JsonObjectInternalFn::getHash(key);
+		const uint32_t slot = JsonObjectInternalFn::findSlot(jsonObject, key, hash);
+		const uint32_t nodeIndex = jsonObject.indexList[slot];
+
+		if (nodeIndex != JsonObjectInternalFn::END_OF_LIST)
+		{
+			jsonObject.nodeList[nodeIndex].pair.second = value;
+			return;
+		}
+
+		JsonObject::Node node;
+		node.pair.first = key;
+		node.pair.second = value;
+		node.hash = hash;
+		jsonObject.indexList[slot] = ArrayFn::pushBack(jsonObject.nodeList, node);
+	}
+
+	inline void clear(JsonObject& jsonObject)
+	{
+		ArrayFn::clear(jsonObject.nodeList);
+		ArrayFn::clear(jsonObject.indexList);
+	}
+
+	inline const JsonObject::Node* begin(const JsonObject& jsonObject)
+	{
+		return ArrayFn::begin(jsonObject.nodeList);
+	}
+
+	inline const JsonObject::Node* end(const JsonObject& jsonObject)
+	{
+		return ArrayFn::end(jsonObject.nodeList);
 	}
 
 } // namespace JsonObjectFn
 
 inline JsonObject::JsonObject(Allocator& a)
-	: jsonMap(a)
+	: nodeList(a)
+	, indexList(a)
 {
 }
 
 // Returns the value of the <key> or nullptr
 inline const char* JsonObject::operator[](const char* key) const
 {
-	return MapFn::get(jsonMap, FixedString(key), (const char*)nullptr);
+	return JsonObjectInternalFn::get(*this, FixedString(key));
 }
 
 // Returns the value of the <key> or nullptr
 inline const char* JsonObject::operator[](const FixedString& key) const
 {
-	return MapFn::get(jsonMap, key, (const char*)nullptr);
+	return JsonObjectInternalFn::get(*this, key);
 }
 
-}
+} // namespace Rio
@@ -1,6 +1,7 @@
 #include "Core/Json/RJson.h"
 
-#include "Core/Containers/Map.h"
+#include "Core/Containers/SmallArray.h"
+#include "Core/Json/JsonObject.h"
 #include "Core/Memory/TempAllocator.h"
 #include "Core/Strings/DynamicString.h"
 #include "Core/Strings/String.h"
@@ -140,23 +141,27 @@ namespace RJsonFn
 		}
 	}
 
-	static const char* parseKey(const char* json, DynamicString& key)
+	// Sets <key> to the key at <json>, pointing into <json> itself, and returns the position following it
+	static const char* parseKey(const char* json, FixedString& key)
 	{
 		RIO_ENSURE(nullptr != json);
 		if (*json == '"')
 		{
-			parseString(json, key);
-			return skipString(json);
+			const char* keyEnd = skipString(json);
+			key = FixedString(json + 1, uint32_t(keyEnd - json) - 2);
+			return keyEnd;
 		}
 
-		while (true)
+		const char* keyBegin = json;
+		while (*json)
 		{
 			if (isspace(*json) || *json == '=' || *json == ':')
 			{
+				key = FixedString(keyBegin, uint32_t(json - keyBegin));
 				return json;
 			}
 
-			key += *json++;
+			++json;
 		}
 
 		RIO_FATAL("Bad key");
@@ -167,8 +172,7 @@ namespace RJsonFn
 	{
 		RIO_ENSURE(nullptr != json);
 
-		TempAllocator512 tempAllocator512;
-	 	Array<char> number(tempAllocator512);
+		SmallArray<char, 64> number(getDefaultScratchAllocator());
 
 		if (*json == '-')
 		{
@@ -332,19 +336,14 @@ namespace RJsonFn
 
 		while (*json)
 		{
-			const char* keyBegin = *json == '"' ? (json + 1) : json;
-
-			TempAllocator256 ta;
-			DynamicString key(ta);
-			json = parseKey(json, key);
-
-			FixedString keyStr(keyBegin, key.getLength());
+			FixedString keyStr;
+			json = parseKey(json, keyStr);
 
 			json = skipSpaces(json);
 			json = skipExpectedToNext(json, (*json == '=') ? '=' : ':');
 			json = skipSpaces(json);
 
-			MapFn::set(object.jsonMap, keyStr, json);
+			JsonObjectFn::set(object, keyStr, json);
 
 			json = skipValue(json);
 			json = skipSpaces(json);
@@ -366,19 +365,14 @@ namespace RJsonFn
 
 			while (*json)
 			{
-				const char* keyBegin = *json == '"' ? (json + 1) : json;
-
-				TempAllocator256 ta;
-				DynamicString key(ta);
-				json = parseKey(json, key);
-
-				FixedString keyStr(keyBegin, key.getLength());
+				FixedString keyStr;
+				json = parseKey(json, keyStr);
 
 				json = skipSpaces(json);
 				json = skipExpectedToNext(json, (*json == '=') ? '=' : ':');
 				json = skipSpaces(json);
 
-				MapFn::set(object.jsonMap, keyStr, json);
+				JsonObjectFn::set(object, keyStr, json);
 
 				json = skipValue(json);
 				json = skipSpaces(json);
@@ -23,9 +23,22 @@ struct JsonValueType
 using JsonArray = Array<const char*>;
 
 // Map from key to pointers to json-encoded data
+// Keys point into the json source too, items are kept in insertion order
+// An open addressing table of item indices, probed with the key hash, makes lookups O(1)
 struct JsonObject
 {
-	Map<FixedString, const char*> jsonMap;
+	struct Node
+	{
+		struct
+		{
+			FixedString first;
+			const char* second = nullptr;
+		} pair;
+		uint32_t hash = 0;
+	};
+
+	Array<Node> nodeList;
+	Array<uint32_t> indexList; // Power of two, UINT32_MAX marks a free slot
 
 	JsonObject(Allocator& a);
 
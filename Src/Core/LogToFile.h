@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Core/FileSystem/Types.h"
+#include "Core/FileSystem/FileSystem.h"
 
 namespace Rio
 {
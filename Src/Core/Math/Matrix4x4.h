@@ -4,7 +4,7 @@
 #include "Core/Math/Matrix3x3.h"
 #include "Core/Math/Quaternion.h"
 #include "Core/Math/Types.h"
-#include "core/math/vector4.h"
+#include "Core/Math/Vector4.h"
 
 namespace Rio
 {
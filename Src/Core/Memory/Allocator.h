@@ -2,6 +2,8 @@
 
 #include "Core/Types.h"
 
+#include <cstring> // memcpy
+
 namespace Rio
 {
 
@@ -26,6 +28,20 @@ struct Allocator
 	// Deallocates a previously allocated block of memory pointed by <data>
 	virtual void deallocate(void* data) = 0;
 
+	// Resizes the block of memory pointed by <data> to <size> bytes aligned to the specified <align> byte
+	// Keeps the first <usedSize> bytes of the block and returns a pointer to it, <data> must not be used afterwards
+	// Allocators which can grow a block without moving it override this, the default always allocates a new block and copies
+	virtual void* reallocate(void* data, uint32_t usedSize, uint32_t size, uint32_t align = DEFAULT_ALIGN)
+	{
+		void* newData = allocate(size, align);
+		if (data != nullptr)
+		{
+			memcpy(newData, data, usedSize);
+			deallocate(data);
+		}
+		return newData;
+	}
+
 	// Returns the size of the memory block pointed by <ptr> or SIZE_NOT_TRACKED if the allocator does not support memory tracking
 	// <ptr> must be a pointer returned by Allocator::allocate()
 	virtual uint32_t getAllocatedSize(const void* ptr) = 0;
@@ -33,8 +49,8 @@ struct Allocator
 	// Returns the total number of bytes allocated
 	virtual uint32_t getTotalAllocatedBytes() = 0;
 
-	// Default memory alignment in bytes
-	static const uint32_t DEFAULT_ALIGN = 4;
+	// Default memory alignment in bytes, enough for aligned SSE loads and stores
+	static const uint32_t DEFAULT_ALIGN = 16;
 	static const uint32_t SIZE_NOT_TRACKED = 0xffffffffu;
 };
 
@@ -0,0 +1,68 @@
+#include "Core/Memory/FrameAllocator.h"
+
+#include "Core/Containers/Array.h"
+
+namespace Rio
+{
+
+namespace FrameAllocatorInternalFn
+{
+	static void freeFallbackList(FrameAllocator::Frame& frame, Allocator& backingAllocator)
+	{
+		for (uint32_t i = 0; i < ArrayFn::getCount(frame.fallbackList); ++i)
+		{
+			backingAllocator.deallocate(frame.fallbackList[i]);
+		}
+		ArrayFn::clear(frame.fallbackList);
+		frame.fallbackBytes = 0;
+	}
+
+} // namespace FrameAllocatorInternalFn
+
+FrameAllocator::Frame::Frame(uint32_t reserveSize, Allocator& backingAllocator)
+	: arena(reserveSize)
+	, fallbackList(backingAllocator)
+{
+}
+
+FrameAllocator::FrameAllocator(uint32_t reserveSize, Allocator& backingAllocator)
+	: backingAllocator(backingAllocator)
+	, frameFirst(reserveSize, backingAllocator)
+	, frameSecond(reserveSize, backingAllocator)
+	, frameCurrent(&frameFirst)
+{
+}
+
+FrameAllocator::~FrameAllocator()
+{
+	FrameAllocatorInternalFn::freeFallbackList(this->frameFirst, this->backingAllocator);
+	FrameAllocatorInternalFn::freeFallbackList(this->frameSecond, this->backingAllocator);
+	this->frameFirst.arena.clear();
+	this->frameSecond.arena.clear();
+}
+
+void* FrameAllocator::allocate(uint32_t size, uint32_t align)
+{
+	void* data = this->frameCurrent->arena.allocate(size, align);
+	if (data != nullptr)
+	{
+		return data;
+	}
+
+	data = this->backingAllocator.allocate(size, align);
+	ArrayFn::pushBack(this->frameCurrent->fallbackList, data);
+	this->frameCurrent->fallbackBytes += size;
+
+	++(this->fallbackCount);
+	this->fallbackBytes += size;
+	return data;
+}
+
+void FrameAllocator::flip()
+{
+	this->frameCurrent = (this->frameCurrent == &(this->frameFirst)) ? &(this->frameSecond) : &(this->frameFirst);
+	FrameAllocatorInternalFn::freeFallbackList(*(this->frameCurrent), this->backingAllocator);
+	this->frameCurrent->arena.clear();
+}
+
+} // namespace Rio
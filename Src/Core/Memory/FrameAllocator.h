@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Core/Containers/Types.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/VirtualArenaAllocator.h"
+
+namespace Rio
+{
+
+// Allocator for memory which only has to live until the end of the next frame
+// Two arenas are used in turn: flip() makes the other arena current and frees everything in it,
+// so the data allocated during frame N is still valid during frame N + 1
+// Individual deallocations are ignored, arenas keep their committed pages so steady state frames never touch the heap
+// It must be used from the main thread only
+struct FrameAllocator : public Allocator
+{
+	// Memory of one frame
+	struct Frame
+	{
+		VirtualArenaAllocator arena;
+		Array<void*> fallbackList; // Blocks served by the backing allocator once <arena> was exhausted
+		uint32_t fallbackBytes = 0;
+
+		Frame(uint32_t reserveSize, Allocator& backingAllocator);
+	};
+
+	Allocator& backingAllocator;
+	Frame frameFirst;
+	Frame frameSecond;
+	Frame* frameCurrent = nullptr;
+
+	// Requests which did not fit in the arena of their frame and were serviced by the backing allocator instead
+	uint32_t fallbackCount = 0;
+	uint32_t fallbackBytes = 0;
+
+	// Reserves <reserveSize> bytes of address space for each of the two arenas
+	// Requests which do not fit in the current arena go to <backingAllocator>, they are freed by flip() all the same
+	FrameAllocator(uint32_t reserveSize, Allocator& backingAllocator = getDefaultAllocator());
+	~FrameAllocator();
+
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+
+	// Memory is freed all at once by flip()
+	void deallocate(void* /*data*/)
+	{
+	}
+
+	// Starts a new frame
+	// Frees all the allocations made two frames ago
+	void flip();
+
+	uint32_t getAllocatedSize(const void* /*ptr*/)
+	{
+		return SIZE_NOT_TRACKED;
+	}
+
+	// Returns the number of bytes allocated during the current frame
+	uint32_t getTotalAllocatedBytes()
+	{
+		return this->frameCurrent->arena.getTotalAllocatedBytes() + this->frameCurrent->fallbackBytes;
+	}
+};
+
+} // namespace Rio
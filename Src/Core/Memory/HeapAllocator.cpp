@@ -0,0 +1,103 @@
+#include "Core/Memory/HeapAllocator.h"
+#include "Core/Memory/Memory.h"
+
+#include <stdlib.h> // malloc
+
+namespace Rio
+{
+
+HeapAllocator::HeapAllocator()
+{
+}
+
+HeapAllocator::~HeapAllocator()
+{
+	RIO_ASSERT(this->allocationCount == 0 && getTotalAllocatedBytes() == 0
+		, "Missing %d deallocations causing a leak of %d bytes"
+		, this->allocationCount
+		, getTotalAllocatedBytes()
+		);
+}
+
+void* HeapAllocator::allocate(uint32_t size, uint32_t align)
+{
+	ScopedMutex scopedMutex(this->mutex);
+
+	uint32_t actualSize = Memory::getActualAllocationSize(size, align);
+
+	Memory::Header* h = (Memory::Header*)malloc(actualSize);
+	h->size = actualSize;
+
+	void* data = Memory::getAlignedToTop(h + 1, align);
+
+	Memory::pad(h, data);
+
+	this->allocatedSize += actualSize;
+	++(this->allocationCount);
+
+	return data;
+}
+
+void HeapAllocator::deallocate(void* data)
+{
+	ScopedMutex scopedMutex(this->mutex);
+
+	if (!data)
+	{
+		return;
+	}
+
+	Memory::Header* h = Memory::getHeader(data);
+
+	this->allocatedSize -= h->size;
+	--(this->allocationCount);
+
+	free(h);
+}
+
+void* HeapAllocator::reallocate(void* data, uint32_t usedSize, uint32_t size, uint32_t align)
+{
+	if (!data)
+	{
+		return allocate(size, align);
+	}
+
+	ScopedMutex scopedMutex(this->mutex);
+
+	Memory::Header* h = Memory::getHeader(data);
+	const uint32_t offset = uint32_t((char*)data - (char*)h);
+	const uint32_t oldSize = h->size;
+	const uint32_t actualSize = Memory::getActualAllocationSize(size, align);
+	RIO_ASSERT(offset + usedSize <= actualSize, "Used size does not fit in the new block");
+
+	// realloc() grows the block in place when it can, otherwise it copies the whole old block
+	h = (Memory::Header*)realloc(h, actualSize);
+	h->size = actualSize;
+
+	void* newData = Memory::realignData(h, sizeof(Memory::Header), offset, usedSize, align);
+
+	this->allocatedSize += actualSize;
+	this->allocatedSize -= oldSize;
+
+	return newData;
+}
+
+uint32_t HeapAllocator::getAllocatedSize(const void* ptr)
+{
+	return getSizeOfBlock(ptr);
+}
+
+uint32_t HeapAllocator::getTotalAllocatedBytes()
+{
+	ScopedMutex scopedMutex(this->mutex);
+	return this->allocatedSize;
+}
+
+uint32_t HeapAllocator::getSizeOfBlock(const void* data)
+{
+	ScopedMutex scopedMutex(this->mutex);
+	Memory::Header* h = Memory::getHeader(data);
+	return h->size;
+}
+
+} // namespace Rio
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Thread/Mutex.h"
+
+namespace Rio
+{
+
+// Allocator based on C malloc()
+// Every call is serialized on a single mutex
+struct HeapAllocator : public Allocator
+{
+	Mutex mutex;
+	uint32_t allocatedSize = 0;
+	uint32_t allocationCount = 0;
+
+	HeapAllocator();
+	~HeapAllocator();
+
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	void deallocate(void* data);
+	void* reallocate(void* data, uint32_t usedSize, uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	uint32_t getAllocatedSize(const void* ptr);
+	uint32_t getTotalAllocatedBytes();
+
+	// Returns the size in bytes of the block of memory pointed by <data>
+	uint32_t getSizeOfBlock(const void* data);
+};
+
+} // namespace Rio
@@ -0,0 +1,172 @@
+#include "Core/Memory/HugePageAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Platform.h"
+
+#if RIO_PLATFORM_POSIX
+	#include <sys/mman.h> // mmap, munmap, madvise
+#elif RIO_PLATFORM_WINDOWS
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#endif
+
+namespace Rio
+{
+
+namespace HugePageAllocatorInternalFn
+{
+	typedef HugePageAllocator::Header Header;
+
+	RIO_STATIC_ASSERT(sizeof(Header) == 8);
+
+	inline uint32_t roundUp(uint32_t size, uint32_t granularity)
+	{
+		return ((size + granularity - 1) / granularity) * granularity;
+	}
+
+	// Maps <size> bytes aligned to HUGE_PAGE_SIZE and backed by huge pages
+	// Returns nullptr if huge pages are not available, otherwise <size> is rounded up to the mapped size
+	static char* map(uint32_t& size)
+	{
+#if RIO_PLATFORM_LINUX && defined(MADV_HUGEPAGE)
+		size = roundUp(size, HugePageAllocator::HUGE_PAGE_SIZE);
+
+		// Over-allocate by one huge page, then trim both ends so the mapping starts on a huge page boundary
+		const size_t mapSize = size_t(size) + HugePageAllocator::HUGE_PAGE_SIZE;
+		void* p = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED)
+		{
+			return nullptr;
+		}
+
+		char* begin = (char*)p;
+		char* base = (char*)Memory::getAlignedToTop(begin, HugePageAllocator::HUGE_PAGE_SIZE);
+		char* end = begin + mapSize;
+		if (base != begin)
+		{
+			munmap(begin, base - begin);
+		}
+		if (base + size != end)
+		{
+			munmap(base + size, end - (base + size));
+		}
+
+		// Only a hint, the kernel falls back to normal pages when THP is disabled
+		madvise(base, size, MADV_HUGEPAGE);
+		return base;
+#elif RIO_PLATFORM_WINDOWS
+		const SIZE_T largePageSize = GetLargePageMinimum();
+		if (largePageSize == 0)
+		{
+			return nullptr;
+		}
+
+		size = roundUp(size, (uint32_t)largePageSize);
+		// Fails unless the process holds SeLockMemoryPrivilege
+		return (char*)VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+#else
+		RIO_UNUSED(size);
+		return nullptr;
+#endif
+	}
+
+	static void unmap(void* base, uint32_t size)
+	{
+#if RIO_PLATFORM_POSIX
+		munmap(base, size);
+#elif RIO_PLATFORM_WINDOWS
+		RIO_UNUSED(size);
+		VirtualFree(base, 0, MEM_RELEASE);
+#endif
+	}
+
+	// Given a pointer to the data, returns a pointer to the header before it
+	inline Header* getHeader(const void* data)
+	{
+		const uint32_t distance = Memory::getHeaderDistance(data);
+		return distance ? (Header*)((char*)data - distance) : (Header*)data - 1;
+	}
+
+} // namespace HugePageAllocatorInternalFn
+
+HugePageAllocator::HugePageAllocator(Allocator& backing, uint32_t threshold)
+	: backingAllocator(backing)
+	, threshold(threshold)
+{
+}
+
+HugePageAllocator::~HugePageAllocator()
+{
+	RIO_ASSERT(this->allocatedSize == 0
+		, "Memory leak of %d bytes, maybe you forgot to call deallocate()?"
+		, this->allocatedSize
+		);
+}
+
+void* HugePageAllocator::allocate(uint32_t size, uint32_t align)
+{
+	using namespace HugePageAllocatorInternalFn;
+
+	RIO_ASSERT(align % 4 == 0, "Must be 4-byte aligned");
+
+	const uint32_t requiredSize = sizeof(Header) + size + align;
+
+	char* base = nullptr;
+	uint32_t mappedSize = 0;
+	if (size >= this->threshold)
+	{
+		mappedSize = requiredSize;
+		base = map(mappedSize);
+		if (base == nullptr)
+		{
+			mappedSize = 0;
+		}
+	}
+
+	if (base == nullptr)
+	{
+		base = (char*)this->backingAllocator.allocate(requiredSize);
+	}
+
+	Header* h = (Header*)base;
+	h->mappedSize = mappedSize;
+	h->size = size;
+
+	void* data = Memory::getAlignedToTop(h + 1, align);
+	Memory::pad(h, h + 1, data);
+
+	this->allocatedSize += size;
+	this->mappedSize += mappedSize;
+	return data;
+}
+
+void HugePageAllocator::deallocate(void* data)
+{
+	using namespace HugePageAllocatorInternalFn;
+
+	if (!data)
+	{
+		return;
+	}
+
+	Header* h = getHeader(data);
+	this->allocatedSize -= h->size;
+
+	if (h->mappedSize != 0)
+	{
+		this->mappedSize -= h->mappedSize;
+		unmap(h, h->mappedSize);
+	}
+	else
+	{
+		this->backingAllocator.deallocate(h);
+	}
+}
+
+uint32_t HugePageAllocator::getAllocatedSize(const void* ptr)
+{
+	return HugePageAllocatorInternalFn::getHeader(ptr)->size;
+}
+
+} // namespace Rio
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Core/Memory/Allocator.h"
+
+namespace Rio
+{
+
+// Puts blocks of at least <threshold> bytes in their own mapping aligned to HUGE_PAGE_SIZE
+// and asks the OS to back it with huge pages, which cuts TLB misses when streaming through big buffers
+// On Linux the mapping is advised with MADV_HUGEPAGE (transparent huge pages)
+// On Windows large pages are used when the process holds the lock pages privilege
+// Smaller blocks, and big ones when no mapping can be made, come from the backing allocator
+// Not thread safe
+struct HugePageAllocator : public Allocator
+{
+	static const uint32_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	// Header stored in front of the data of every block
+	// <size> must be the last member, it is the word before the data when there is no padding
+	// The header is at the start of the mapping or of the backing allocation
+	struct Header
+	{
+		uint32_t mappedSize; // 0 when the block comes from the backing allocator
+		uint32_t size;
+	};
+
+	Allocator& backingAllocator;
+	uint32_t threshold = 0;
+	uint32_t allocatedSize = 0;
+	uint32_t mappedSize = 0;
+
+	// Blocks of <threshold> bytes or more are put on huge pages
+	// A threshold below HUGE_PAGE_SIZE trades memory for fewer TLB misses, since mappings are rounded up to it
+	HugePageAllocator(Allocator& backing, uint32_t threshold = HUGE_PAGE_SIZE);
+	~HugePageAllocator();
+
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	void deallocate(void* data);
+	uint32_t getAllocatedSize(const void* ptr);
+
+	uint32_t getTotalAllocatedBytes()
+	{
+		return this->allocatedSize;
+	}
+
+	// Returns the number of bytes mapped for big blocks
+	uint32_t getMappedBytes() const
+	{
+		return this->mappedSize;
+	}
+};
+
+} // namespace Rio
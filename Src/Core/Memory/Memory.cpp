@@ -1,247 +1,304 @@
 #include "Core/Memory/Allocator.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+#include "Core/Memory/TrackingAllocator.h"
+#include "Core/Platform.h"
+#include "Core/Thread/Atomic.h"
 #include "Core/Thread/Mutex.h"
 
-#include <stdlib.h> // malloc
+#if RIO_PLATFORM_POSIX
+	#include <pthread.h>
+#endif
 
 namespace Rio
 {
 
 namespace Memory
 {
-	// Header stored at the beginning of a memory allocation to indicate the size of the allocated data
-	struct Header
-	{
-		uint32_t size;
-	};
-
-	// If we need to align the memory allocation we pad the header with this value after storing the size
-	const uint32_t HEADER_PAD_VALUE = 0xffffffffu;
+	// Slot sizes are multiples of 4, so the low bit of the size marks a free slot
+	// The high bit is HEADER_PAD_FLAG, which getHeader() would take for a pad distance
+	const uint32_t SLOT_FREE_BIT = 0x00000001u;
 
-	// Given a pointer to the header, returns a pointer to the data that follows it
-	inline void* getDataPointer(Header* header, uint32_t align)
-	{
-		void* p = header + 1;
-		return Memory::getAlignedToTop(p, align);
-	}
+	// An allocator used to allocate temporary "scratch" memory
+	// Each thread gets its own fixed size ring buffer to service the requests
+	// The ring is created the first time the thread uses the allocator
+	// and is handed over to another thread when its owner exits
 
-	// Given a pointer to the data, returns a pointer to the header before it
-	inline Header* getHeader(const void* data)
-	{
-		uint32_t* p = (uint32_t*)data;
-		while (p[-1] == HEADER_PAD_VALUE)
-		{
-			--p;
-		}
-		return (Header*)p - 1;
-	}
+	// Memory is always always allocated linearly
+	// An allocation pointer is advanced through the buffer
+	// as memory is allocated and wraps around at the end of the buffer
+	// Similarly, a free pointer is advanced as memory is freed
 
-	// Stores the size in the header and pads with HEADER_PAD_VALUE up to the data pointer
-	inline void fill(Header* header, void* data, uint32_t size)
-	{
-		header->size = size;
-		uint32_t *p = (uint32_t*)(header + 1);
-		while (p < data)
-		{
-			*p++ = HEADER_PAD_VALUE;
-		}
-	}
+	// Only the owning thread moves the pointers of a ring, so no lock is taken
+	// Any thread may free a slot, which just marks it free, the owner then advances past it
 
-	inline uint32_t getActualAllocationSize(uint32_t size, uint32_t align)
-	{
-		return size + align + sizeof(Header);
-	}
+	// It is important that the scratch allocator is only used for short-lived memory allocations
+	// A long lived allocator will lock the "free" pointer and prevent the "allocate" pointer from proceeding past it,
+	// which means the ring buffer can't be used
 
-	inline void pad(Header* header, void* data)
+	// If the ring buffer is exhausted, the scratch allocator will use its
+	// backing allocator to allocate memory instead
+	struct ScratchAllocator : public Allocator
 	{
-		uint32_t* p = (uint32_t*)(header + 1);
-
-		while (p != data)
+		// Ring buffer owned by a single thread
+		struct Ring
 		{
-			*p = HEADER_PAD_VALUE;
-			p++;
-		}
-	}
+			ScratchAllocator* allocator = nullptr;
+			Ring* next = nullptr;
+			bool isOwned = false;
 
-	// Allocator based on C malloc()
-	struct HeapAllocator : public Allocator
-	{
-		Mutex mutex;
-		uint32_t allocatedSize = 0;
-		uint32_t allocationCount = 0;
+			// Start and end of the ring buffer
+			char* bufferBegin = nullptr;
+			char* bufferEnd = nullptr;
 
-		HeapAllocator()
-		{
-		}
+			// Pointers to where to allocate memory and where to free memory
+			char* whereToAllocate = nullptr;
+			char* whereToFree = nullptr;
+		};
 
-		~HeapAllocator()
-		{
-			RIO_ASSERT(allocationCount == 0 && getTotalAllocatedBytes() == 0
-				, "Missing %d deallocations causing a leak of %d bytes"
-				, allocationCount
-				, getTotalAllocatedBytes()
-				);
-		}
+		Allocator& backingAllocator;
+		uint32_t ringSize = 0;
+		uint32_t allocatorId = 0; // Tags the thread local ring pointer
 
-		void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN)
-		{
-			ScopedMutex scopedMutex(mutex);
+		Mutex mutex; // Taken only to create or adopt a ring
+		Ring* ringList = nullptr; // Rings are only ever added, until the allocator is destroyed
+		uint32_t ringCount = 0;
 
-			uint32_t actualSize = getActualAllocationSize(size, align);
+		// Requests which did not fit in the ring of the calling thread and went to the backing allocator
+		uint32_t fallbackCount = 0;
+		uint32_t fallbackBytes = 0;
 
-			Header* h = (Header*)malloc(actualSize);
-			h->size = actualSize;
+#if RIO_PLATFORM_POSIX
+		pthread_key_t ringKey;
+#elif RIO_PLATFORM_WINDOWS
+		DWORD ringKey;
+#endif
 
-			void* data = Memory::getAlignedToTop(h + 1, align);
+		static uint32_t nextAllocatorId;
+		static RIO_THREAD uint32_t tlsAllocatorId;
+		static RIO_THREAD Ring* tlsRing;
 
-			pad(h, data);
+		// Creates a ScratchAllocator
+		// The allocator will use the <backingAllocator> to create the ring buffers
+		// and to service any requests that don't fit in the ring buffer
+		// <size> specifies the size of the ring buffer of each thread
+		ScratchAllocator(Allocator& backingAllocator, uint32_t size)
+			: backingAllocator(backingAllocator)
+			, ringSize(size)
+		{
+			RIO_ASSERT(size % 4 == 0, "Ring size must be a multiple of 4");
+			this->allocatorId = AtomicFn::fetchAdd(&nextAllocatorId, 1) + 1;
+
+#if RIO_PLATFORM_POSIX
+			int err = pthread_key_create(&(this->ringKey), releaseRing);
+			RIO_ASSERT(err == 0, "pthread_key_create: errno = %d", err);
+			RIO_UNUSED(err);
+#elif RIO_PLATFORM_WINDOWS
+			this->ringKey = FlsAlloc(releaseRing);
+			RIO_ASSERT(this->ringKey != FLS_OUT_OF_INDEXES, "FlsAlloc: GetLastError = %d", GetLastError());
+#endif
+		}
 
-			allocatedSize += actualSize;
-			++allocationCount;
+		~ScratchAllocator()
+		{
+#if RIO_PLATFORM_POSIX
+			pthread_key_delete(this->ringKey);
+#elif RIO_PLATFORM_WINDOWS
+			FlsFree(this->ringKey);
+#endif
+
+			Ring* ring = this->ringList;
+			while (ring)
+			{
+				advanceFree(*ring);
+				RIO_ASSERT(ring->whereToFree == ring->whereToAllocate, "Memory leak");
 
-			return data;
+				Ring* next = ring->next;
+				backingAllocator.deallocate(ring->bufferBegin);
+				RIO_DELETE(backingAllocator, ring);
+				ring = next;
+			}
 		}
 
-		void deallocate(void* data)
+		// Called when the thread which owns <data> exits
+#if RIO_PLATFORM_POSIX
+		static void releaseRing(void* data)
+#elif RIO_PLATFORM_WINDOWS
+		static void WINAPI releaseRing(void* data)
+#endif
 		{
-			ScopedMutex scopedMutex(mutex);
-
 			if (!data)
 			{
 				return;
 			}
 
-			Header* h = getHeader(data);
-
-			allocatedSize -= h->size;
-			--allocationCount;
-
-			free(h);
+			Ring* ring = (Ring*)data;
+			ScopedMutex scopedMutex(ring->allocator->mutex);
+			ring->isOwned = false;
 		}
 
-		uint32_t getAllocatedSize(const void* ptr)
-		{
-			return getSizeOfBlock(ptr);
-		}
-
-		uint32_t getTotalAllocatedBytes()
+		// Returns the ring of the calling thread, creating or adopting one if needed
+		Ring& getRing()
 		{
-			ScopedMutex scopedMutex(mutex);
-			return allocatedSize;
-		}
-
-		// Returns the size in bytes of the block of memory pointed by <data>
-		uint32_t getSizeOfBlock(const void* data)
-		{
-			ScopedMutex scopedMutex(mutex);
-			Header* h = getHeader(data);
-			return h->size;
-		}
-	};
+			if (tlsAllocatorId == this->allocatorId)
+			{
+				return *tlsRing;
+			}
 
-	// An allocator used to allocate temporary "scratch" memory
-	// The allocator uses a fixed size ring buffer to services the requests
+#if RIO_PLATFORM_POSIX
+			Ring* ring = (Ring*)pthread_getspecific(this->ringKey);
+#elif RIO_PLATFORM_WINDOWS
+			Ring* ring = (Ring*)FlsGetValue(this->ringKey);
+#endif
 
-	// Memory is always always allocated linearly
-	// An allocation pointer is advanced through the buffer 
-	// as memory is allocated and wraps around at the end of the buffer
-	// Similarly, a free pointer is advanced as memory is freed
+			if (!ring)
+			{
+				ScopedMutex scopedMutex(this->mutex);
 
-	// It is important that the scratch allocator is only used for short-lived memory allocations
-	// A long lived allocator will lock the "free" pointer and prevent the "allocate" pointer from proceeding past it, 
-	// which means the ring buffer can't be used
+				ring = this->ringList;
+				while (ring && ring->isOwned)
+				{
+					ring = ring->next;
+				}
 
-	// If the ring buffer is exhausted, the scratch allocator will use its 
-	// backing allocator to allocate memory instead
-	struct ScratchAllocator : public Allocator
-	{
-		Mutex mutex;
-		Allocator& backingAllocator;
+				if (!ring)
+				{
+					ring = RIO_NEW(backingAllocator, Ring)();
+					ring->allocator = this;
+					ring->bufferBegin = (char*)backingAllocator.allocate(this->ringSize);
+					ring->bufferEnd = ring->bufferBegin + this->ringSize;
+					ring->whereToAllocate = ring->bufferBegin;
+					ring->whereToFree = ring->bufferBegin;
+
+					ring->next = this->ringList;
+					this->ringList = ring;
+					++(this->ringCount);
+				}
 
-		// Start and end of the ring buffer
-		char* bufferBegin = nullptr;
-		char* bufferEnd = nullptr;
+				ring->isOwned = true;
 
-		// Pointers to where to allocate memory and where to free memory
-		char* whereToAllocate = nullptr;
-		char* whereToFree = nullptr;
+#if RIO_PLATFORM_POSIX
+				pthread_setspecific(this->ringKey, ring);
+#elif RIO_PLATFORM_WINDOWS
+				FlsSetValue(this->ringKey, ring);
+#endif
+			}
 
-		// Creates a ScratchAllocator
-		// The allocator will use the <backingAllocator> to create the ring buffer 
-		// and to service any requests that don't fit in the ring buffer
-		// <size> specifies the size of the ring buffer
-		ScratchAllocator(Allocator& backingAllocator, uint32_t size)
-			: backingAllocator(backingAllocator)
-		{
-			bufferBegin = (char*)(this->backingAllocator).allocate(size);
-			bufferEnd = bufferBegin + size;
-			whereToAllocate = bufferBegin;
-			whereToFree = bufferBegin;
+			tlsAllocatorId = this->allocatorId;
+			tlsRing = ring;
+			return *ring;
 		}
 
-		~ScratchAllocator()
+		// Returns the ring <p> has been allocated from, or nullptr if it comes from the backing allocator
+		Ring* findRing(const void* p)
 		{
-			RIO_ASSERT(whereToFree == whereToAllocate, "Memory leak");
-			backingAllocator.deallocate(bufferBegin);
-		}
+			if (tlsAllocatorId == this->allocatorId && p >= tlsRing->bufferBegin && p < tlsRing->bufferEnd)
+			{
+				return tlsRing;
+			}
 
-		bool getIsInUse(void* p)
-		{
-			if (whereToFree == whereToAllocate)
+			ScopedMutex scopedMutex(this->mutex);
+			for (Ring* ring = this->ringList; ring; ring = ring->next)
 			{
-				return false;
+				if (p >= ring->bufferBegin && p < ring->bufferEnd)
+				{
+					return ring;
+				}
 			}
-			if (whereToAllocate > whereToFree)
+			return nullptr;
+		}
+
+		// Advances the free pointer of <ring> past all free slots
+		// Must be called by the owner of the ring only
+		static void advanceFree(Ring& ring)
+		{
+			while (ring.whereToFree != ring.whereToAllocate)
 			{
-				return p >= whereToFree && p < whereToAllocate;
+				Header* h = (Header*)ring.whereToFree;
+				const uint32_t size = AtomicFn::loadAcquire(&h->size);
+				if ((size & SLOT_FREE_BIT) == 0)
+				{
+					break;
+				}
+
+				ring.whereToFree += size & ~SLOT_FREE_BIT;
+				if (ring.whereToFree == ring.bufferEnd)
+				{
+					ring.whereToFree = ring.bufferBegin;
+				}
 			}
-			return p >= whereToFree || p < whereToAllocate;
 		}
 
 		void* allocate(uint32_t size, uint32_t align)
 		{
-			ScopedMutex scopedMutex(mutex);
-
 			RIO_ASSERT(align % 4 == 0, "Must be 4-byte aligned");
 			size = ((size + 3)/4)*4;
 
-			char* p = whereToAllocate;
-			Header* h = (Header*)p;
+			Ring& ring = getRing();
+
+			// Reclaim the slots freed by other threads
+			advanceFree(ring);
+
+			// Nothing is in use, start over from the beginning of the buffer
+			if (ring.whereToFree == ring.whereToAllocate)
+			{
+				ring.whereToFree = ring.bufferBegin;
+				ring.whereToAllocate = ring.bufferBegin;
+			}
+
+			Header* h = (Header*)ring.whereToAllocate;
 			char* data = (char*)getDataPointer(h, align);
-			p = data + size;
+			char* p = data + size;
 
-			// Reached the end of the buffer, wrap around to the beginning
-			if (p > bufferEnd)
+			if (ring.whereToAllocate >= ring.whereToFree)
 			{
-				h->size = uint32_t(bufferEnd - (char*)h) | 0x80000000u;
+				// Reached the end of the buffer, wrap around to the beginning
+				// There is always room left at the end for the header which marks the skipped tail
+				if (p >= ring.bufferEnd)
+				{
+					Header* wrappedHeader = (Header*)ring.bufferBegin;
+					char* wrappedData = (char*)getDataPointer(wrappedHeader, align);
+					char* wrappedP = wrappedData + size;
 
-				p = bufferBegin;
-				h = (Header*)p;
-				data = (char*)getDataPointer(h, align);
-				p = data + size;
-			}
+					// If the buffer is exhausted use the backing allocator instead
+					if (wrappedP >= ring.whereToFree)
+					{
+						return allocateFallback(size, align);
+					}
 
-			// If the buffer is exhausted use the backing allocator instead
-			if (getIsInUse(p))
+					h->size = uint32_t(ring.bufferEnd - (char*)h) | SLOT_FREE_BIT;
+
+					h = wrappedHeader;
+					data = wrappedData;
+					p = wrappedP;
+				}
+			}
+			else if (p >= ring.whereToFree)
 			{
-				return backingAllocator.allocate(size, align);
+				return allocateFallback(size, align);
 			}
 
 			fill(h, data, uint32_t(p - (char*)h));
-			whereToAllocate = p;
+			ring.whereToAllocate = p;
 			return data;
 		}
 
-		void deallocate(void *p)
+		void* allocateFallback(uint32_t size, uint32_t align)
 		{
-			ScopedMutex scopedMutex(mutex);
+			AtomicFn::fetchAdd(&(this->fallbackCount), 1);
+			AtomicFn::fetchAdd(&(this->fallbackBytes), size);
+			return backingAllocator.allocate(size, align);
+		}
 
+		void deallocate(void *p)
+		{
 			if (!p)
 			{
 				return;
 			}
 
-			if (p < bufferBegin || p >= bufferEnd)
+			Ring* ring = findRing(p);
+			if (!ring)
 			{
 				backingAllocator.deallocate(p);
 				return;
@@ -249,61 +306,95 @@ namespace Memory
 
 			// Mark this slot as free
 			Header* h = getHeader(p);
-			RIO_ASSERT((h->size & 0x80000000u) == 0, "Not free");
-			h->size = h->size | 0x80000000u;
+			RIO_ASSERT((h->size & SLOT_FREE_BIT) == 0, "Not free");
+			AtomicFn::storeRelease(&h->size, h->size | SLOT_FREE_BIT);
 
-			// Advance the free pointer past all free slots
-			while (whereToFree != whereToAllocate)
+			if (ring == tlsRing && tlsAllocatorId == this->allocatorId)
 			{
-				Header* h = (Header*)whereToFree;
-				if ((h->size & 0x80000000u) == 0)
-				{
-					break;
-				}
-
-				whereToFree += h->size & 0x7fffffffu;
-				if (whereToFree == bufferEnd)
-				{
-					whereToFree = bufferBegin;
-				}
+				advanceFree(*ring);
 			}
 		}
 
 		uint32_t getAllocatedSize(const void* p)
 		{
-			ScopedMutex scopedMutex(mutex);
+			if (!findRing(p))
+			{
+				return backingAllocator.getAllocatedSize(p);
+			}
+
 			Header* h = getHeader(p);
+			RIO_ASSERT((h->size & SLOT_FREE_BIT) == 0, "Already freed");
 			return h->size - uint32_t((char*)p - (char*)h);
 		}
 
 		uint32_t getTotalAllocatedBytes()
 		{
-			ScopedMutex scopedMutex(mutex);
-			return uint32_t(bufferEnd - bufferBegin);
+			ScopedMutex scopedMutex(this->mutex);
+			return this->ringCount * this->ringSize;
 		}
 	};
 
+	uint32_t ScratchAllocator::nextAllocatorId = 0;
+	RIO_THREAD uint32_t ScratchAllocator::tlsAllocatorId = 0;
+	RIO_THREAD ScratchAllocator::Ring* ScratchAllocator::tlsRing = nullptr;
+
 } // namespace Memory
 
 namespace MemoryGlobalFn
 {
 	using namespace Memory;
 
-	static const uint32_t auxBufferSize = sizeof(HeapAllocator) + sizeof(ScratchAllocator);
+	static const uint32_t auxBufferSize = sizeof(ThreadCachingAllocator) + sizeof(TrackingAllocator) + sizeof(ScratchAllocator);
 	char auxBuffer[auxBufferSize];
-	HeapAllocator* defaultAllocator = nullptr;
+	ThreadCachingAllocator* threadCachingAllocator = nullptr;
+	TrackingAllocator* trackingAllocator = nullptr;
+	Allocator* defaultAllocator = nullptr;
 	ScratchAllocator* defaultScratchAllocator = nullptr;
 
 	void init()
 	{
-		defaultAllocator = new (auxBuffer) HeapAllocator();
-		defaultScratchAllocator = new (auxBuffer + sizeof(HeapAllocator)) ScratchAllocator(*defaultAllocator, 1024*1024);
+		char* buffer = auxBuffer;
+		threadCachingAllocator = new (buffer) ThreadCachingAllocator();
+		defaultAllocator = threadCachingAllocator;
+		buffer += sizeof(ThreadCachingAllocator);
+
+#if RIO_MEMORY_TRACKING
+		trackingAllocator = new (buffer) TrackingAllocator(*threadCachingAllocator);
+		defaultAllocator = trackingAllocator;
+#endif // RIO_MEMORY_TRACKING
+		buffer += sizeof(TrackingAllocator);
+
+		defaultScratchAllocator = new (buffer) ScratchAllocator(*defaultAllocator, 1024*1024);
 	}
 
 	void shutdown()
 	{
 		defaultScratchAllocator->~ScratchAllocator();
-		defaultAllocator->~HeapAllocator();
+		if (trackingAllocator != nullptr)
+		{
+			trackingAllocator->~TrackingAllocator();
+			trackingAllocator = nullptr;
+		}
+		threadCachingAllocator->~ThreadCachingAllocator();
+	}
+
+	void logAllocationSites(uint32_t count)
+	{
+		if (trackingAllocator != nullptr)
+		{
+			trackingAllocator->logTopSites(count, TrackingAllocator::SortBy::LIVE_BYTES);
+			trackingAllocator->logTopSites(count, TrackingAllocator::SortBy::ALLOCATION_COUNT);
+		}
+	}
+
+	uint32_t getScratchFallbackCount()
+	{
+		return AtomicFn::loadAcquire(&(defaultScratchAllocator->fallbackCount));
+	}
+
+	uint32_t getScratchFallbackBytes()
+	{
+		return AtomicFn::loadAcquire(&(defaultScratchAllocator->fallbackBytes));
 	}
 
 } // namespace MemoryGlobalFn
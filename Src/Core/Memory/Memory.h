@@ -4,7 +4,9 @@
 #include "Core/Memory/Allocator.h"
 #include "Core/Types.h"
 
+#include <cstring> // memmove
 #include <new>
+#include <type_traits> // std::is_trivially_copyable
 
 namespace Rio
 {
@@ -31,6 +33,82 @@ namespace Memory
 		return (void*)ptr;
 	}
 
+	// Header stored at the beginning of a memory allocation to indicate the size of the allocated data
+	struct Header
+	{
+		uint32_t size;
+	};
+
+	// If we need to align the memory allocation the word right before the data stores
+	// this flag together with the distance in bytes from the header to the data
+	// so the header is found in constant time for any alignment
+	// Sizes stored in headers must never have this bit set
+	const uint32_t HEADER_PAD_FLAG = 0x80000000u;
+
+	// Given a pointer to the header, returns a pointer to the data that follows it
+	inline void* getDataPointer(Header* header, uint32_t align)
+	{
+		void* p = header + 1;
+		return Memory::getAlignedToTop(p, align);
+	}
+
+	// Given a pointer to the data, returns the distance in bytes to the header before it
+	// or 0 if the data immediately follows the header
+	inline uint32_t getHeaderDistance(const void* data)
+	{
+		const uint32_t word = ((const uint32_t*)data)[-1];
+		return (word & HEADER_PAD_FLAG) ? (word & ~HEADER_PAD_FLAG) : 0;
+	}
+
+	// Given a pointer to the data, returns a pointer to the header before it
+	inline Header* getHeader(const void* data)
+	{
+		const uint32_t distance = getHeaderDistance(data);
+		return distance ? (Header*)((char*)data - distance) : (Header*)data - 1;
+	}
+
+	// Stores the distance from <header>, which ends at <headerEnd>, to <data> in the word before <data>
+	inline void pad(void* header, void* headerEnd, void* data)
+	{
+		if (data != headerEnd)
+		{
+			((uint32_t*)data)[-1] = HEADER_PAD_FLAG | uint32_t((char*)data - (char*)header);
+		}
+	}
+
+	// Stores the size in the header and the distance to the header right before the data pointer
+	inline void fill(Header* header, void* data, uint32_t size)
+	{
+		RIO_ASSERT((size & HEADER_PAD_FLAG) == 0, "Size collides with HEADER_PAD_FLAG");
+		header->size = size;
+		pad(header, header + 1, data);
+	}
+
+	// Returns where the data of a block resized by realloc() must be, given the new address of its <headerSize> bytes header
+	// The data was <offset> bytes after the header, the new block may have a different alignment,
+	// so the first <usedSize> bytes are moved to where the header says they are and the padding is stored again
+	inline void* realignData(void* header, uint32_t headerSize, uint32_t offset, uint32_t usedSize, uint32_t align)
+	{
+		char* headerEnd = (char*)header + headerSize;
+		void* data = getAlignedToTop(headerEnd, align);
+		if ((char*)data != (char*)header + offset)
+		{
+			memmove(data, (char*)header + offset, usedSize);
+		}
+		pad(header, headerEnd, data);
+		return data;
+	}
+
+	inline uint32_t getActualAllocationSize(uint32_t size, uint32_t align)
+	{
+		return size + align + sizeof(Header);
+	}
+
+	inline void pad(Header* header, void* data)
+	{
+		pad(header, header + 1, data);
+	}
+
 	// Respects standard behavior when calling on NULL [ptr]
 	template <typename T>
 	inline void callDestructorAndDeallocate(Allocator& a, T* ptr)
@@ -77,6 +155,32 @@ struct IsAllocatorAware
 #define IS_ALLOCATOR_AWARE(T) IsAllocatorAware<T>::value
 #define IS_ALLOCATOR_AWARE_TYPE(T) Int2Type<IS_ALLOCATOR_AWARE(T)>
 
+// Marks a type whose objects can be moved to another address with memcpy, without calling constructors or destructors
+// That holds for types which only point to memory they own and never to themselves, like the containers
+#define TRIVIALLY_RELOCATABLE typedef Int2Type<true> triviallyRelocatableMarker
+
+// Opts a type out of the TRIVIALLY_RELOCATABLE marker of its base
+#define NOT_TRIVIALLY_RELOCATABLE typedef Int2Type<false> triviallyRelocatableMarker
+
+// Determines if a type can be relocated with memcpy
+// Trivially copyable types always can, other types when they are marked TRIVIALLY_RELOCATABLE
+template <typename T>
+struct IsTriviallyRelocatable
+{
+	template <typename C>
+	static typename C::triviallyRelocatableMarker testFunction(typename C::triviallyRelocatableMarker*);
+
+	template <typename C>
+	static Int2Type<std::is_trivially_copyable<C>::value> testFunction(...);
+
+	enum
+	{
+		value = decltype(testFunction<T>(0))::value
+	};
+};
+
+#define IS_TRIVIALLY_RELOCATABLE(T) IsTriviallyRelocatable<T>::value
+
 // Allocator aware constuction
 template <typename T> inline T& construct(void* p, Allocator& a, Int2Type<true>) 
 {
@@ -105,6 +209,17 @@ namespace MemoryGlobalFn
 	// Should be the last call of the program
 	void shutdown();
 
+	// Returns how many requests to the default scratch allocator did not fit in the ring of the calling thread
+	// and were serviced by the default allocator instead
+	uint32_t getScratchFallbackCount();
+
+	// Returns the total size in bytes of the requests counted by getScratchFallbackCount()
+	uint32_t getScratchFallbackBytes();
+
+	// Logs the <count> call sites holding the most memory and the <count> call sites allocating the most often
+	// Does nothing unless built with RIO_MEMORY_TRACKING
+	void logAllocationSites(uint32_t count);
+
 } // namespace MemoryGlobalFn
 
 } // namespace Rio
@@ -0,0 +1,142 @@
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
+
+namespace Rio
+{
+
+namespace PoolAllocatorInternalFn
+{
+	// Returns the size of a chunk which holds <blocksPerChunk> blocks after the chunk header
+	inline uint32_t getChunkSize(const PoolAllocator& poolAllocator)
+	{
+		return sizeof(PoolAllocator::Chunk) + poolAllocator.blockAlign + poolAllocator.blockSize * poolAllocator.blocksPerChunk;
+	}
+
+	inline void* allocate(PoolAllocator& poolAllocator)
+	{
+		PoolAllocator::FreeNode* node = poolAllocator.freeList;
+		if (node)
+		{
+			poolAllocator.freeList = node->next;
+			++poolAllocator.allocationCount;
+			return node;
+		}
+
+		if (poolAllocator.chunkCursor + poolAllocator.blockSize > poolAllocator.chunkEnd)
+		{
+			const uint32_t chunkSize = getChunkSize(poolAllocator);
+			PoolAllocator::Chunk* chunk = (PoolAllocator::Chunk*)poolAllocator.backingAllocator->allocate(chunkSize, alignof(PoolAllocator::Chunk));
+			chunk->next = poolAllocator.chunkList;
+			poolAllocator.chunkList = chunk;
+			++poolAllocator.chunkCount;
+
+			poolAllocator.chunkCursor = (char*)Memory::getAlignedToTop(chunk + 1, poolAllocator.blockAlign);
+			poolAllocator.chunkEnd = (char*)chunk + chunkSize;
+		}
+
+		void* data = poolAllocator.chunkCursor;
+		poolAllocator.chunkCursor += poolAllocator.blockSize;
+		++poolAllocator.allocationCount;
+		return data;
+	}
+
+	inline void deallocate(PoolAllocator& poolAllocator, void* data)
+	{
+		RIO_ASSERT(poolAllocator.getIsOwned(data), "Pointer does not belong to this pool");
+
+		PoolAllocator::FreeNode* node = (PoolAllocator::FreeNode*)data;
+		node->next = poolAllocator.freeList;
+		poolAllocator.freeList = node;
+		--poolAllocator.allocationCount;
+	}
+
+} // namespace PoolAllocatorInternalFn
+
+PoolAllocator::PoolAllocator(Allocator& backingAllocator, uint32_t blockSize, uint32_t blockAlign, uint32_t blocksPerChunk, bool isThreadSafe)
+	: backingAllocator(&backingAllocator)
+	, blockAlign(blockAlign < alignof(FreeNode) ? alignof(FreeNode) : blockAlign)
+	, blocksPerChunk(blocksPerChunk)
+	, isThreadSafe(isThreadSafe)
+{
+	RIO_ASSERT(blocksPerChunk > 0, "Chunks must hold at least one block");
+
+	// Every block must be able to hold a free list node and keep the next block aligned
+	blockSize = blockSize < sizeof(FreeNode) ? sizeof(FreeNode) : blockSize;
+	this->blockSize = ((blockSize + this->blockAlign - 1) / this->blockAlign) * this->blockAlign;
+}
+
+PoolAllocator::~PoolAllocator()
+{
+	RIO_ASSERT(this->allocationCount == 0
+		, "Missing %d deallocations causing a leak of %d bytes"
+		, this->allocationCount
+		, this->allocationCount * this->blockSize
+		);
+
+	Chunk* chunk = this->chunkList;
+	while (chunk)
+	{
+		Chunk* next = chunk->next;
+		this->backingAllocator->deallocate(chunk);
+		chunk = next;
+	}
+}
+
+void* PoolAllocator::allocate(uint32_t size, uint32_t align)
+{
+	RIO_ASSERT(size <= this->blockSize, "Size %d exceeds the block size %d", size, this->blockSize);
+	RIO_ASSERT(this->blockAlign % align == 0, "Alignment %d is not compatible with the block alignment %d", align, this->blockAlign);
+	RIO_UNUSED(size);
+	RIO_UNUSED(align);
+
+	if (this->isThreadSafe)
+	{
+		ScopedMutex scopedMutex(this->mutex);
+		return PoolAllocatorInternalFn::allocate(*this);
+	}
+
+	return PoolAllocatorInternalFn::allocate(*this);
+}
+
+void PoolAllocator::deallocate(void* data)
+{
+	if (!data)
+	{
+		return;
+	}
+
+	if (this->isThreadSafe)
+	{
+		ScopedMutex scopedMutex(this->mutex);
+		PoolAllocatorInternalFn::deallocate(*this, data);
+		return;
+	}
+
+	PoolAllocatorInternalFn::deallocate(*this, data);
+}
+
+uint32_t PoolAllocator::getTotalAllocatedBytes()
+{
+	if (this->isThreadSafe)
+	{
+		ScopedMutex scopedMutex(this->mutex);
+		return this->allocationCount * this->blockSize;
+	}
+
+	return this->allocationCount * this->blockSize;
+}
+
+bool PoolAllocator::getIsOwned(const void* data)
+{
+	const uint32_t chunkSize = PoolAllocatorInternalFn::getChunkSize(*this);
+	for (Chunk* chunk = this->chunkList; chunk; chunk = chunk->next)
+	{
+		if (data > (const void*)chunk && data < (const void*)((char*)chunk + chunkSize))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace Rio
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Thread/Mutex.h"
+
+namespace Rio
+{
+
+// Allocates blocks of a single fixed size out of chunks obtained from a backing allocator
+// Both allocate() and deallocate() are O(1): free blocks are kept in an intrusive free list
+// Chunks are returned to the backing allocator only when the pool is destroyed
+struct PoolAllocator : public Allocator
+{
+	// Free block, linked through its own memory
+	struct FreeNode
+	{
+		FreeNode* next;
+	};
+
+	// Header at the beginning of each chunk
+	struct Chunk
+	{
+		Chunk* next;
+	};
+
+	Allocator* backingAllocator = nullptr;
+	uint32_t blockSize = 0;
+	uint32_t blockAlign = 0;
+	uint32_t blocksPerChunk = 0;
+	bool isThreadSafe = false;
+	Mutex mutex; // Taken only if isThreadSafe
+
+	FreeNode* freeList = nullptr;
+	Chunk* chunkList = nullptr;
+	// Blocks of the last chunk which have never been handed out
+	char* chunkCursor = nullptr;
+	char* chunkEnd = nullptr;
+
+	uint32_t allocationCount = 0;
+	uint32_t chunkCount = 0;
+
+	// Creates a pool of blocks of <blockSize> bytes aligned to <blockAlign>
+	// Chunks of <blocksPerChunk> blocks are allocated from <backingAllocator> as needed
+	// If <isThreadSafe> is true the pool can be used from multiple threads at once
+	PoolAllocator(Allocator& backingAllocator, uint32_t blockSize, uint32_t blockAlign = Allocator::DEFAULT_ALIGN, uint32_t blocksPerChunk = 64, bool isThreadSafe = false);
+	~PoolAllocator();
+
+	// <size> and <align> must not exceed the block size and alignment of the pool
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	void deallocate(void* data);
+
+	uint32_t getAllocatedSize(const void* /*ptr*/)
+	{
+		return this->blockSize;
+	}
+
+	uint32_t getTotalAllocatedBytes();
+
+	// Returns whether <data> belongs to one of the chunks of the pool
+	bool getIsOwned(const void* data);
+};
+
+} // namespace Rio
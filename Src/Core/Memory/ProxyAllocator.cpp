@@ -1,33 +1,202 @@
 #include "Core/Error/Error.h"
+#include "Core/Log.h"
 #include "Core/Memory/ProxyAllocator.h"
 #include "Core/Profiler.h"
+#include "Core/Strings/StringStream.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/Mutex.h"
+
+namespace
+{
+	const Rio::LogInternal::System MEMORY = { "Memory" };
+}
 
 namespace Rio
 {
 
+namespace ProxyAllocatorInternalFn
+{
+	// Protects the global list of proxy allocators
+	static Mutex proxyListMutex;
+	static ProxyAllocator* proxyListHead = nullptr;
+
+	// Raises <peak> to <value> if it is lower
+	inline void updatePeak(uint32_t* peak, uint32_t value)
+	{
+		uint32_t current = AtomicFn::loadRelaxed(peak);
+		while (current < value)
+		{
+			// A failed swap reloads <current>
+			if (AtomicFn::compareAndSwap(peak, current, value))
+			{
+				break;
+			}
+		}
+	}
+
+	// Returns the size of <data> as reported by the backing allocator, 0 if it does not track sizes
+	inline uint32_t getTrackedSize(Allocator& allocator, const void* data)
+	{
+		const uint32_t size = allocator.getAllocatedSize(data);
+		return size == Allocator::SIZE_NOT_TRACKED ? 0 : size;
+	}
+
+	static void onBudgetExceeded(ProxyAllocator& proxyAllocator, uint32_t allocatedSize)
+	{
+		// Log only on the allocation which crosses the budget, not on every allocation after it
+		if (AtomicFn::exchange(&proxyAllocator.isOverBudget, 1) == 0)
+		{
+			LogInternal::logExtended(proxyAllocator.isBudgetHard ? LogSeverity::LOG_ERROR : LogSeverity::LOG_WARN
+				, MEMORY
+				, "Proxy allocator '%s' exceeded its budget: %u > %u bytes"
+				, proxyAllocator.name
+				, allocatedSize
+				, proxyAllocator.budget
+				);
+		}
+
+		RIO_ASSERT(!proxyAllocator.isBudgetHard
+			, "Proxy allocator '%s' exceeded its hard budget: %u > %u bytes"
+			, proxyAllocator.name
+			, allocatedSize
+			, proxyAllocator.budget
+			);
+	}
+
+} // namespace ProxyAllocatorInternalFn
+
 ProxyAllocator::ProxyAllocator(Allocator& allocator, const char* name)
 	: allocator(allocator)
 	, name(name)
 {
 	RIO_ASSERT(name != nullptr, "Name must be != nullptr");
+
+	using namespace ProxyAllocatorInternalFn;
+	ScopedMutex scopedMutex(proxyListMutex);
+	this->next = proxyListHead;
+	if (proxyListHead != nullptr)
+	{
+		proxyListHead->previous = this;
+	}
+	proxyListHead = this;
+}
+
+ProxyAllocator::~ProxyAllocator()
+{
+	using namespace ProxyAllocatorInternalFn;
+	ScopedMutex scopedMutex(proxyListMutex);
+	if (this->previous != nullptr)
+	{
+		this->previous->next = this->next;
+	}
+	else
+	{
+		proxyListHead = this->next;
+	}
+	if (this->next != nullptr)
+	{
+		this->next->previous = this->previous;
+	}
 }
 
 void* ProxyAllocator::allocate(uint32_t size, uint32_t align)
 {
+	using namespace ProxyAllocatorInternalFn;
+
 	void* p = this->allocator.allocate(size, align);
-	ALLOCATE_MEMORY(this->name, this->allocator.getAllocatedSize(p));
+	const uint32_t actualSize = getTrackedSize(this->allocator, p);
+	ALLOCATE_MEMORY(this->name, actualSize);
+
+	const uint32_t newAllocatedSize = AtomicFn::fetchAdd(&(this->allocatedSize), actualSize) + actualSize;
+	AtomicFn::fetchAdd(&(this->allocationCount), 1);
+	updatePeak(&(this->peakAllocatedSize), newAllocatedSize);
+
+	const uint32_t budget = AtomicFn::loadRelaxed(&(this->budget));
+	if (budget != 0 && newAllocatedSize > budget)
+	{
+		onBudgetExceeded(*this, newAllocatedSize);
+	}
+
 	return p;
 }
 
 void ProxyAllocator::deallocate(void* data)
 {
-	DEALLOCATE_MEMORY(this->name, (data == nullptr) ? 0 : this->allocator.getAllocatedSize((const void*)data));
+	using namespace ProxyAllocatorInternalFn;
+
+	if (data == nullptr)
+	{
+		DEALLOCATE_MEMORY(this->name, 0);
+		this->allocator.deallocate(data);
+		return;
+	}
+
+	const uint32_t actualSize = getTrackedSize(this->allocator, data);
+	DEALLOCATE_MEMORY(this->name, actualSize);
+
+	const uint32_t newAllocatedSize = AtomicFn::fetchSub(&(this->allocatedSize), actualSize) - actualSize;
+	AtomicFn::fetchSub(&(this->allocationCount), 1);
+
+	if (AtomicFn::loadRelaxed(&(this->isOverBudget)) != 0 && newAllocatedSize <= AtomicFn::loadRelaxed(&(this->budget)))
+	{
+		AtomicFn::exchange(&(this->isOverBudget), 0);
+	}
+
 	this->allocator.deallocate(data);
 }
 
+uint32_t ProxyAllocator::getTotalAllocatedBytes()
+{
+	return AtomicFn::loadRelaxed(&(this->allocatedSize));
+}
+
+uint32_t ProxyAllocator::getPeakAllocatedBytes()
+{
+	return AtomicFn::loadRelaxed(&(this->peakAllocatedSize));
+}
+
+uint32_t ProxyAllocator::getAllocationCount()
+{
+	return AtomicFn::loadRelaxed(&(this->allocationCount));
+}
+
+void ProxyAllocator::setBudget(uint32_t bytes, bool isHard)
+{
+	this->isBudgetHard = isHard;
+	AtomicFn::exchange(&(this->budget), bytes);
+	AtomicFn::exchange(&(this->isOverBudget), 0);
+}
+
 const char* ProxyAllocator::getProxyAllocatorName() const
 {
 	return this->name;
 }
 
+namespace ProxyAllocatorFn
+{
+	void writeJsonSnapshot(StringStream& stringStream)
+	{
+		using namespace ProxyAllocatorInternalFn;
+		ScopedMutex scopedMutex(proxyListMutex);
+
+		stringStream << "[";
+		for (ProxyAllocator* proxyAllocator = proxyListHead; proxyAllocator != nullptr; proxyAllocator = proxyAllocator->next)
+		{
+			stringStream << "{\"name\":\"" << proxyAllocator->name << "\"";
+			stringStream << ",\"allocatedBytes\":" << proxyAllocator->getTotalAllocatedBytes();
+			stringStream << ",\"peakAllocatedBytes\":" << proxyAllocator->getPeakAllocatedBytes();
+			stringStream << ",\"allocationCount\":" << proxyAllocator->getAllocationCount();
+			stringStream << ",\"budget\":" << AtomicFn::loadRelaxed(&(proxyAllocator->budget));
+			stringStream << ",\"isBudgetHard\":" << (proxyAllocator->isBudgetHard ? "true" : "false");
+			stringStream << "}";
+			if (proxyAllocator->next != nullptr)
+			{
+				stringStream << ",";
+			}
+		}
+		stringStream << "]";
+	}
+
+} // namespace ProxyAllocatorFn
+
 } // namespace Rio
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Memory/Allocator.h"
+#include "Core/Strings/Types.h"
 
 namespace Rio
 {
@@ -8,29 +9,61 @@ namespace Rio
 // Offers the facility to tag allocators by a string identifier
 // Proxy allocator is appended to a global linked list when instantiated
 // so that it is possible to later visit that list for debugging purposes
+// Live bytes, peak bytes and the number of live allocations are tracked with atomic counters
+// Sizes are the ones reported by the backing allocator, allocators which do not track them only count allocations
 struct ProxyAllocator : public Allocator
 {
 	Allocator& allocator;
 	const char* name = nullptr;
 
+	// Links in the global list of proxy allocators
+	ProxyAllocator* previous = nullptr;
+	ProxyAllocator* next = nullptr;
+
+	uint32_t allocatedSize = 0;
+	uint32_t peakAllocatedSize = 0;
+	uint32_t allocationCount = 0;
+
+	// 0 means no budget
+	uint32_t budget = 0;
+	// A hard budget asserts when exceeded, a soft one only logs a warning
+	bool isBudgetHard = false;
+	// Set while over budget, so that the warning is logged once each time the budget is exceeded
+	uint32_t isOverBudget = 0;
+
 	// Tag all allocations made with <allocator> by the given <name>
 	ProxyAllocator(Allocator& allocator, const char* name);
+	~ProxyAllocator();
 
 	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
 	void deallocate(void* data);
-	
-	uint32_t getAllocatedSize(const void* /*ptr*/) 
+
+	uint32_t getAllocatedSize(const void* ptr)
 	{
-		return SIZE_NOT_TRACKED; 
+		return this->allocator.getAllocatedSize(ptr);
 	}
 
-	uint32_t getTotalAllocatedBytes() 
-	{ 
-		return SIZE_NOT_TRACKED; 
-	}
+	// Returns the number of bytes currently allocated through this proxy
+	uint32_t getTotalAllocatedBytes();
+
+	// Returns the highest number of bytes ever allocated through this proxy at the same time
+	uint32_t getPeakAllocatedBytes();
+
+	// Returns the number of live allocations made through this proxy
+	uint32_t getAllocationCount();
+
+	// Sets the maximum number of bytes this proxy is expected to hold, 0 removes the budget
+	void setBudget(uint32_t bytes, bool isHard);
 
 	// Returns the name of the proxy allocator
 	const char* getProxyAllocatorName() const;
 };
 
+namespace ProxyAllocatorFn
+{
+	// Writes a JSON array with name, live bytes, peak bytes, allocation count and budget of every proxy allocator to <stringStream>
+	void writeJsonSnapshot(StringStream& stringStream);
+
+} // namespace ProxyAllocatorFn
+
 } // namespace Rio
@@ -0,0 +1,422 @@
+#include "Core/Memory/ThreadCachingAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Thread/Atomic.h"
+
+#include <stdlib.h> // malloc
+#include <string.h> // memcpy, memset
+
+namespace Rio
+{
+
+namespace ThreadCachingAllocatorInternalFn
+{
+	typedef ThreadCachingAllocator::BlockHeader BlockHeader;
+	typedef ThreadCachingAllocator::FreeBlock FreeBlock;
+	typedef ThreadCachingAllocator::Span Span;
+	typedef ThreadCachingAllocator::ThreadCache ThreadCache;
+
+	RIO_STATIC_ASSERT(sizeof(BlockHeader) == 16);
+
+	// Unique, never reused, ids for threads and allocator instances
+	static uint32_t nextThreadId = 0;
+	static uint32_t nextAllocatorId = 0;
+
+	static RIO_THREAD uint32_t threadId = 0;
+
+	// Last cache used by this thread, valid only while tlsAllocatorId matches ThreadCachingAllocator::allocatorId
+	static RIO_THREAD uint32_t tlsAllocatorId = 0;
+	static RIO_THREAD ThreadCache* tlsCache = nullptr;
+
+	// Counters of a cache are written only by the thread which owns it
+	// so a relaxed read-modify-write is enough, no locked instruction is needed
+	inline void ownerAdd(int32_t* value, int32_t amount)
+	{
+		AtomicFn::storeRelaxed(value, AtomicFn::loadRelaxed(value) + amount);
+	}
+
+	// Pushes <block> onto the remote free list of <cache>
+	// Many threads may push concurrently, only the owner takes the whole list with takeRemote()
+	inline void pushRemote(ThreadCache* cache, FreeBlock* block)
+	{
+		FreeBlock* head = AtomicFn::loadRelaxed(&cache->remoteFreeList);
+		do
+		{
+			block->next = head;
+		}
+		while (!AtomicFn::compareAndSwap(&cache->remoteFreeList, head, block));
+	}
+
+	inline FreeBlock* takeRemote(ThreadCache* cache)
+	{
+		if (AtomicFn::loadRelaxed(&cache->remoteFreeList) == nullptr)
+		{
+			return nullptr;
+		}
+		return AtomicFn::exchange(&cache->remoteFreeList, (FreeBlock*)nullptr, MemoryOrder::ACQ_REL);
+	}
+
+	inline uint32_t getThreadId()
+	{
+		if (threadId == 0)
+		{
+			threadId = AtomicFn::fetchAdd(&nextThreadId, 1) + 1;
+		}
+		return threadId;
+	}
+
+	// Returns the index of the smallest size class which holds <size> bytes
+	inline uint32_t getSizeClass(uint32_t size)
+	{
+		uint32_t sizeClass = 0;
+		uint32_t blockSize = ThreadCachingAllocator::MIN_BLOCK_SIZE;
+		while (blockSize < size)
+		{
+			blockSize <<= 1;
+			++sizeClass;
+		}
+		return sizeClass;
+	}
+
+	inline uint32_t getBlockSize(uint32_t sizeClass)
+	{
+		return ThreadCachingAllocator::MIN_BLOCK_SIZE << sizeClass;
+	}
+
+	// Given a pointer to the data, returns a pointer to the block header before it
+	inline BlockHeader* getBlockHeader(const void* data)
+	{
+		const uint32_t distance = Memory::getHeaderDistance(data);
+		return distance ? (BlockHeader*)((char*)data - distance) : (BlockHeader*)data - 1;
+	}
+
+	// Called when a thread which owned <cache> exits
+	// The cache keeps its free blocks and is handed to the next thread that asks for one
+#if RIO_PLATFORM_POSIX
+	static void releaseThreadCache(void* data)
+#elif RIO_PLATFORM_WINDOWS
+	static void WINAPI releaseThreadCache(void* data)
+#endif
+	{
+		if (!data)
+		{
+			return;
+		}
+
+		ThreadCache* cache = (ThreadCache*)data;
+		ScopedMutex scopedMutex(cache->allocator->mutex);
+		cache->ownerThreadId = 0;
+	}
+
+	// Returns a block of <sizeClass> when the local free list of <cache> is empty
+	static FreeBlock* refill(ThreadCache* cache, uint32_t sizeClass)
+	{
+		// Reclaim the blocks other threads have freed in the meantime
+		FreeBlock* remote = takeRemote(cache);
+		while (remote)
+		{
+			FreeBlock* next = remote->next;
+			const uint32_t remoteClass = remote->header.sizeClass;
+			remote->next = cache->freeList[remoteClass];
+			cache->freeList[remoteClass] = remote;
+			remote = next;
+		}
+
+		FreeBlock* block = cache->freeList[sizeClass];
+		if (block)
+		{
+			cache->freeList[sizeClass] = block->next;
+			return block;
+		}
+
+		// Carve a new block out of the current span, or start a new span
+		const uint32_t blockSize = getBlockSize(sizeClass);
+		if (cache->spanCursor[sizeClass] + blockSize > cache->spanEnd[sizeClass])
+		{
+			Span* span = (Span*)malloc(ThreadCachingAllocator::SPAN_SIZE);
+			span->next = cache->spanList;
+			cache->spanList = span;
+
+			cache->spanCursor[sizeClass] = (char*)Memory::getAlignedToTop(span + 1, sizeof(BlockHeader));
+			cache->spanEnd[sizeClass] = (char*)span + ThreadCachingAllocator::SPAN_SIZE;
+		}
+
+		block = (FreeBlock*)cache->spanCursor[sizeClass];
+		cache->spanCursor[sizeClass] += blockSize;
+		return block;
+	}
+
+} // namespace ThreadCachingAllocatorInternalFn
+
+ThreadCachingAllocator::ThreadCachingAllocator()
+{
+	using namespace ThreadCachingAllocatorInternalFn;
+
+	this->allocatorId = AtomicFn::fetchAdd(&nextAllocatorId, 1) + 1;
+
+#if RIO_PLATFORM_POSIX
+	int err = pthread_key_create(&(this->threadExitKey), releaseThreadCache);
+	RIO_ASSERT(err == 0, "pthread_key_create: errno = %d", err);
+	RIO_UNUSED(err);
+#elif RIO_PLATFORM_WINDOWS
+	this->threadExitKey = FlsAlloc(releaseThreadCache);
+	RIO_ASSERT(this->threadExitKey != FLS_OUT_OF_INDEXES, "FlsAlloc: GetLastError = %d", GetLastError());
+#endif
+}
+
+ThreadCachingAllocator::~ThreadCachingAllocator()
+{
+	RIO_ASSERT(getAllocationCount() == 0 && getTotalAllocatedBytes() == 0
+		, "Missing %d deallocations causing a leak of %d bytes"
+		, getAllocationCount()
+		, getTotalAllocatedBytes()
+		);
+
+#if RIO_PLATFORM_POSIX
+	pthread_key_delete(this->threadExitKey);
+#elif RIO_PLATFORM_WINDOWS
+	FlsFree(this->threadExitKey);
+#endif
+
+	ThreadCache* cache = this->cacheList;
+	while (cache)
+	{
+		Span* span = cache->spanList;
+		while (span)
+		{
+			Span* next = span->next;
+			free(span);
+			span = next;
+		}
+
+		ThreadCache* next = cache->next;
+		cache->~ThreadCache();
+		free(cache);
+		cache = next;
+	}
+}
+
+ThreadCachingAllocator::ThreadCache* ThreadCachingAllocator::getThreadCache()
+{
+	using namespace ThreadCachingAllocatorInternalFn;
+
+	if (tlsAllocatorId == this->allocatorId)
+	{
+		return tlsCache;
+	}
+
+	const uint32_t currentThreadId = getThreadId();
+
+	ScopedMutex scopedMutex(this->mutex);
+
+	// The thread may already own a cache if it has been switching between allocators
+	ThreadCache* cache = this->cacheList;
+	while (cache && cache->ownerThreadId != currentThreadId)
+	{
+		cache = cache->next;
+	}
+
+	// Adopt the cache left by a thread which has exited
+	if (!cache)
+	{
+		cache = this->cacheList;
+		while (cache && cache->ownerThreadId != 0)
+		{
+			cache = cache->next;
+		}
+	}
+
+	if (!cache)
+	{
+		cache = new (malloc(sizeof(ThreadCache))) ThreadCache();
+		memset(cache->freeList, 0, sizeof(cache->freeList));
+		memset(cache->spanCursor, 0, sizeof(cache->spanCursor));
+		memset(cache->spanEnd, 0, sizeof(cache->spanEnd));
+		cache->allocator = this;
+		cache->next = this->cacheList;
+		this->cacheList = cache;
+	}
+
+	cache->ownerThreadId = currentThreadId;
+
+#if RIO_PLATFORM_POSIX
+	pthread_setspecific(this->threadExitKey, cache);
+#elif RIO_PLATFORM_WINDOWS
+	FlsSetValue(this->threadExitKey, cache);
+#endif
+
+	tlsAllocatorId = this->allocatorId;
+	tlsCache = cache;
+	return cache;
+}
+
+void* ThreadCachingAllocator::allocate(uint32_t size, uint32_t align)
+{
+	using namespace ThreadCachingAllocatorInternalFn;
+
+	// Blocks start at 16 bytes boundaries so the data right after the header
+	// is already aligned for any <align> up to sizeof(BlockHeader)
+	const uint32_t requiredSize = sizeof(BlockHeader) + size + (align > sizeof(BlockHeader) ? align : 0);
+
+	if (requiredSize > MAX_BLOCK_SIZE)
+	{
+		const uint32_t actualSize = size + align + sizeof(BlockHeader);
+
+		BlockHeader* h = (BlockHeader*)malloc(actualSize);
+		memset(h, 0, sizeof(BlockHeader));
+		h->sizeClass = LARGE_BLOCK;
+		h->size = actualSize;
+
+		void* data = Memory::getAlignedToTop(h + 1, align);
+		Memory::pad(h, h + 1, data);
+
+		AtomicFn::fetchAdd(&(this->largeAllocatedSize), (int32_t)actualSize);
+		AtomicFn::fetchAdd(&(this->largeAllocationCount), 1);
+
+		return data;
+	}
+
+	const uint32_t sizeClass = getSizeClass(requiredSize);
+	ThreadCache* cache = getThreadCache();
+
+	FreeBlock* block = cache->freeList[sizeClass];
+	if (block)
+	{
+		cache->freeList[sizeClass] = block->next;
+	}
+	else
+	{
+		block = refill(cache, sizeClass);
+	}
+
+	BlockHeader* h = &block->header;
+	h->owner = cache;
+#if !RIO_ARCH_64BIT
+	h->padding = 0;
+#endif
+	h->sizeClass = sizeClass;
+	h->size = getBlockSize(sizeClass);
+
+	void* data = Memory::getAlignedToTop(h + 1, align);
+	Memory::pad(h, h + 1, data);
+
+	ownerAdd(&(cache->allocatedSize), (int32_t)h->size);
+	ownerAdd(&(cache->allocationCount), 1);
+
+	return data;
+}
+
+void ThreadCachingAllocator::deallocate(void* data)
+{
+	using namespace ThreadCachingAllocatorInternalFn;
+
+	if (!data)
+	{
+		return;
+	}
+
+	BlockHeader* h = getBlockHeader(data);
+
+	if (h->owner == nullptr)
+	{
+		AtomicFn::fetchAdd(&(this->largeAllocatedSize), -(int32_t)h->size);
+		AtomicFn::fetchAdd(&(this->largeAllocationCount), -1);
+		free(h);
+		return;
+	}
+
+	// The freeing thread accounts for the block, so that counters are only ever written by their owner
+	ThreadCache* cache = getThreadCache();
+	ownerAdd(&(cache->allocatedSize), -(int32_t)h->size);
+	ownerAdd(&(cache->allocationCount), -1);
+
+	FreeBlock* block = (FreeBlock*)h;
+	if (h->owner == cache)
+	{
+		block->next = cache->freeList[h->sizeClass];
+		cache->freeList[h->sizeClass] = block;
+	}
+	else
+	{
+		pushRemote(h->owner, block);
+	}
+}
+
+void* ThreadCachingAllocator::reallocate(void* data, uint32_t usedSize, uint32_t size, uint32_t align)
+{
+	using namespace ThreadCachingAllocatorInternalFn;
+
+	if (!data)
+	{
+		return allocate(size, align);
+	}
+
+	BlockHeader* h = getBlockHeader(data);
+	const uint32_t offset = uint32_t((char*)data - (char*)h);
+	const uint32_t requiredSize = sizeof(BlockHeader) + size + (align > sizeof(BlockHeader) ? align : 0);
+
+	if (h->owner != nullptr)
+	{
+		// Size classes are powers of two, so a block often has room to grow without moving
+		if (offset + size <= h->size && (uintptr_t)data % align == 0)
+		{
+			return data;
+		}
+	}
+	else if (requiredSize > MAX_BLOCK_SIZE)
+	{
+		const uint32_t actualSize = size + align + sizeof(BlockHeader);
+		if (offset + usedSize <= actualSize)
+		{
+			const uint32_t oldSize = h->size;
+
+			// realloc() extends large blocks in place or remaps their pages, instead of copying them
+			h = (BlockHeader*)realloc(h, actualSize);
+			h->size = actualSize;
+
+			void* newData = Memory::realignData(h, sizeof(BlockHeader), offset, usedSize, align);
+
+			AtomicFn::fetchAdd(&(this->largeAllocatedSize), (int32_t)actualSize - (int32_t)oldSize);
+			return newData;
+		}
+	}
+
+	void* newData = allocate(size, align);
+	memcpy(newData, data, usedSize);
+	deallocate(data);
+	return newData;
+}
+
+uint32_t ThreadCachingAllocator::getAllocatedSize(const void* ptr)
+{
+	return ThreadCachingAllocatorInternalFn::getBlockHeader(ptr)->size;
+}
+
+uint32_t ThreadCachingAllocator::getTotalAllocatedBytes()
+{
+	using namespace ThreadCachingAllocatorInternalFn;
+
+	ScopedMutex scopedMutex(this->mutex);
+
+	int32_t total = AtomicFn::loadRelaxed(&(this->largeAllocatedSize));
+	for (ThreadCache* cache = this->cacheList; cache; cache = cache->next)
+	{
+		total += AtomicFn::loadRelaxed(&(cache->allocatedSize));
+	}
+	return (uint32_t)total;
+}
+
+uint32_t ThreadCachingAllocator::getAllocationCount()
+{
+	using namespace ThreadCachingAllocatorInternalFn;
+
+	ScopedMutex scopedMutex(this->mutex);
+
+	int32_t total = AtomicFn::loadRelaxed(&(this->largeAllocationCount));
+	for (ThreadCache* cache = this->cacheList; cache; cache = cache->next)
+	{
+		total += AtomicFn::loadRelaxed(&(cache->allocationCount));
+	}
+	return (uint32_t)total;
+}
+
+} // namespace Rio
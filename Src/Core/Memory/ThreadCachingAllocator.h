@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Platform.h"
+#include "Core/Thread/Mutex.h"
+
+#if RIO_PLATFORM_POSIX
+	#include <pthread.h>
+#endif
+
+namespace Rio
+{
+
+// General purpose allocator with a cache of free blocks for each thread
+// Small requests are served from per-thread size class free lists without taking any lock
+// Blocks freed by a thread other than the one which allocated them are pushed
+// onto the owner's lock-free remote list and reclaimed by the owner on its next refill
+// Requests bigger than the largest size class go straight to malloc()
+struct ThreadCachingAllocator : public Allocator
+{
+	static const uint32_t SIZE_CLASS_COUNT = 8; // 32, 64, ..., 4096 bytes
+	static const uint32_t MIN_BLOCK_SIZE = 32;
+	static const uint32_t MAX_BLOCK_SIZE = MIN_BLOCK_SIZE << (SIZE_CLASS_COUNT - 1);
+	static const uint32_t SPAN_SIZE = 64 * 1024;
+	static const uint32_t LARGE_BLOCK = 0xffffffffu;
+
+	struct ThreadCache;
+
+	// Header stored in front of the data of every block
+	// <size> must be the last member, it is the word before the data when there is no padding
+	struct BlockHeader
+	{
+		ThreadCache* owner; // nullptr for large blocks
+#if !RIO_ARCH_64BIT
+		uint32_t padding;
+#endif
+		uint32_t sizeClass;
+		uint32_t size;
+	};
+
+	// Free block, linked through the first bytes of its data
+	struct FreeBlock
+	{
+		BlockHeader header;
+		FreeBlock* next;
+	};
+
+	// Chunk of SPAN_SIZE bytes carved into blocks of a single size class
+	struct Span
+	{
+		Span* next;
+	};
+
+	struct ThreadCache
+	{
+		ThreadCachingAllocator* allocator = nullptr;
+		ThreadCache* next = nullptr;
+		uint32_t ownerThreadId = 0; // 0 when the owning thread has exited
+
+		FreeBlock* freeList[SIZE_CLASS_COUNT];
+		char* spanCursor[SIZE_CLASS_COUNT];
+		char* spanEnd[SIZE_CLASS_COUNT];
+		Span* spanList = nullptr;
+
+		// Updated only by the owning thread, read by anyone
+		int32_t allocatedSize = 0;
+		int32_t allocationCount = 0;
+
+		// Written by other threads, kept on its own cache line
+		char padding[RIO_CACHE_LINE_SIZE];
+		FreeBlock* remoteFreeList = nullptr;
+	};
+
+	uint32_t allocatorId = 0; // Unique for each instance, tags the thread local cache pointer
+	Mutex mutex; // Protects cacheList, taken only when a thread gets its cache
+	ThreadCache* cacheList = nullptr;
+
+	// Large blocks are not owned by any cache
+	int32_t largeAllocatedSize = 0;
+	int32_t largeAllocationCount = 0;
+
+#if RIO_PLATFORM_POSIX
+	pthread_key_t threadExitKey;
+#elif RIO_PLATFORM_WINDOWS
+	DWORD threadExitKey;
+#endif
+
+	ThreadCachingAllocator();
+	~ThreadCachingAllocator();
+
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	void deallocate(void* data);
+	void* reallocate(void* data, uint32_t usedSize, uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	uint32_t getAllocatedSize(const void* ptr);
+
+	// Returns the total number of bytes allocated
+	// The value is exact only when no other thread is allocating
+	uint32_t getTotalAllocatedBytes();
+
+	// Returns the number of live allocations
+	uint32_t getAllocationCount();
+
+	// Returns the cache of the calling thread, creating or adopting one if needed
+	ThreadCache* getThreadCache();
+};
+
+} // namespace Rio
@@ -0,0 +1,293 @@
+#include "Core/Error/Callstack.h"
+#include "Core/Log.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/TrackingAllocator.h"
+#include "Core/Murmur.h"
+#include "Core/Strings/StringStream.h"
+
+#include <string.h> // memcmp, memmove, memset
+
+namespace
+{
+	const Rio::LogInternal::System MEMORY = { "Memory" };
+}
+
+namespace Rio
+{
+
+namespace TrackingAllocatorInternalFn
+{
+	typedef TrackingAllocator::CallSite CallSite;
+	typedef TrackingAllocator::Header Header;
+
+	// Skips the frame of TrackingAllocator::allocate() itself
+	static const uint32_t SKIP_FRAME_COUNT = 1;
+
+	// Sites are never removed, so the table only needs to stay reasonably sparse for probing to be short
+	static const uint32_t MAX_USED_SITE_COUNT = TrackingAllocator::MAX_SITE_COUNT / 4 * 3;
+
+	// Given a pointer to the data, returns a pointer to the header before it
+	inline Header* getHeader(const void* data)
+	{
+		const uint32_t distance = Memory::getHeaderDistance(data);
+		return distance ? (Header*)((char*)data - distance) : (Header*)data - 1;
+	}
+
+	// Returns the index of the site with the given call stack, adding it if needed
+	static uint32_t findOrAddSite(TrackingAllocator& trackingAllocator, void* const* frameList, uint32_t frameCount)
+	{
+		uint32_t hash = murmur32(frameList, frameCount * sizeof(void*), 0);
+		hash = (hash == 0) ? 1 : hash;
+
+		const uint32_t mask = TrackingAllocator::MAX_SITE_COUNT - 1;
+		for (uint32_t index = hash & mask; ; index = (index + 1) & mask)
+		{
+			CallSite& site = trackingAllocator.siteList[index];
+			if (site.hash == 0)
+			{
+				if (trackingAllocator.siteCount == MAX_USED_SITE_COUNT)
+				{
+					return TrackingAllocator::OVERFLOW_SITE_INDEX;
+				}
+
+				site.hash = hash;
+				site.frameCount = frameCount;
+				memcpy(site.frameList, frameList, frameCount * sizeof(void*));
+				++(trackingAllocator.siteCount);
+				return index;
+			}
+
+			if (site.hash == hash
+				&& site.frameCount == frameCount
+				&& memcmp(site.frameList, frameList, frameCount * sizeof(void*)) == 0
+				)
+			{
+				return index;
+			}
+		}
+	}
+
+	inline uint64_t getSortValue(const CallSite& site, TrackingAllocator::SortBy::Enum sortBy)
+	{
+		return sortBy == TrackingAllocator::SortBy::LIVE_BYTES ? site.allocatedSize : site.totalAllocationCount;
+	}
+
+	// Copies up to <count> sites with the highest <sortBy> value to <topSiteList>, highest first
+	// Returns the number of sites copied
+	static uint32_t collectTopSites(TrackingAllocator& trackingAllocator, CallSite* topSiteList, uint32_t count, TrackingAllocator::SortBy::Enum sortBy)
+	{
+		ScopedMutex scopedMutex(trackingAllocator.mutex);
+
+		uint32_t topCount = 0;
+		for (uint32_t i = 0; i <= TrackingAllocator::MAX_SITE_COUNT; ++i)
+		{
+			const CallSite& site = trackingAllocator.siteList[i];
+			const uint64_t value = getSortValue(site, sortBy);
+			if (value == 0)
+			{
+				continue;
+			}
+
+			// Insertion into the sorted top list, count is small
+			uint32_t position = topCount;
+			while (position > 0 && getSortValue(topSiteList[position - 1], sortBy) < value)
+			{
+				--position;
+			}
+
+			if (position == count)
+			{
+				continue;
+			}
+
+			const uint32_t moveCount = (topCount == count ? count - 1 : topCount) - position;
+			memmove(topSiteList + position + 1, topSiteList + position, moveCount * sizeof(CallSite));
+			topSiteList[position] = site;
+			topCount = (topCount == count) ? count : topCount + 1;
+		}
+
+		return topCount;
+	}
+
+	static void writeSite(StringStream& stringStream, uint32_t rank, const CallSite& site)
+	{
+		stringStream << "Call site #" << rank << ": ";
+		stringStream << site.allocatedSize << " bytes in " << site.allocationCount << " live allocations, ";
+		stringStream << site.totalAllocationCount << " allocations in total\n";
+
+		if (site.frameCount == 0)
+		{
+			stringStream << "    <other call sites>\n";
+		}
+		else
+		{
+			ErrorFn::writeFrameList(stringStream, site.frameList, site.frameCount);
+		}
+	}
+
+} // namespace TrackingAllocatorInternalFn
+
+TrackingAllocator::TrackingAllocator(Allocator& backing)
+	: backingAllocator(backing)
+{
+	const uint32_t size = (MAX_SITE_COUNT + 1) * sizeof(CallSite);
+	this->siteList = (CallSite*)backing.allocate(size, alignof(CallSite));
+	memset(this->siteList, 0, size);
+}
+
+TrackingAllocator::~TrackingAllocator()
+{
+	if (this->allocationCount != 0)
+	{
+		LogInternal::logExtended(LogSeverity::LOG_ERROR
+			, MEMORY
+			, "Missing %d deallocations causing a leak of %d bytes"
+			, this->allocationCount
+			, this->allocatedSize
+			);
+		logTopSites(10, SortBy::LIVE_BYTES);
+	}
+
+	this->backingAllocator.deallocate(this->siteList);
+
+	RIO_ASSERT(this->allocationCount == 0 && this->allocatedSize == 0
+		, "Missing %d deallocations causing a leak of %d bytes"
+		, this->allocationCount
+		, this->allocatedSize
+		);
+}
+
+void* TrackingAllocator::allocate(uint32_t size, uint32_t align)
+{
+	using namespace TrackingAllocatorInternalFn;
+
+	void* frameList[MAX_FRAME_COUNT];
+	const uint32_t frameCount = ErrorFn::captureFrameList(frameList, MAX_FRAME_COUNT, SKIP_FRAME_COUNT);
+
+	Header* h = (Header*)this->backingAllocator.allocate(sizeof(Header) + size + align);
+	h->size = size;
+
+	void* data = Memory::getAlignedToTop(h + 1, align);
+	Memory::pad(h, h + 1, data);
+
+	ScopedMutex scopedMutex(this->mutex);
+
+	h->siteIndex = findOrAddSite(*this, frameList, frameCount);
+
+	CallSite& site = this->siteList[h->siteIndex];
+	site.allocatedSize += size;
+	++(site.allocationCount);
+	++(site.totalAllocationCount);
+
+	this->allocatedSize += size;
+	++(this->allocationCount);
+
+	return data;
+}
+
+void TrackingAllocator::deallocate(void* data)
+{
+	using namespace TrackingAllocatorInternalFn;
+
+	if (!data)
+	{
+		return;
+	}
+
+	Header* h = getHeader(data);
+
+	{
+		ScopedMutex scopedMutex(this->mutex);
+
+		CallSite& site = this->siteList[h->siteIndex];
+		site.allocatedSize -= h->size;
+		--(site.allocationCount);
+
+		this->allocatedSize -= h->size;
+		--(this->allocationCount);
+	}
+
+	this->backingAllocator.deallocate(h);
+}
+
+void* TrackingAllocator::reallocate(void* data, uint32_t usedSize, uint32_t size, uint32_t align)
+{
+	using namespace TrackingAllocatorInternalFn;
+
+	if (!data)
+	{
+		return allocate(size, align);
+	}
+
+	// The block keeps the call site it was first allocated from
+	Header* h = getHeader(data);
+	const uint32_t offset = uint32_t((char*)data - (char*)h);
+	const uint32_t oldSize = h->size;
+	RIO_ASSERT(offset + usedSize <= sizeof(Header) + size + align, "Used size does not fit in the new block");
+
+	h = (Header*)this->backingAllocator.reallocate(h, offset + usedSize, sizeof(Header) + size + align);
+	h->size = size;
+
+	void* newData = Memory::realignData(h, sizeof(Header), offset, usedSize, align);
+
+	ScopedMutex scopedMutex(this->mutex);
+
+	CallSite& site = this->siteList[h->siteIndex];
+	site.allocatedSize += size;
+	site.allocatedSize -= oldSize;
+
+	this->allocatedSize += size;
+	this->allocatedSize -= oldSize;
+
+	return newData;
+}
+
+uint32_t TrackingAllocator::getAllocatedSize(const void* ptr)
+{
+	return TrackingAllocatorInternalFn::getHeader(ptr)->size;
+}
+
+uint32_t TrackingAllocator::getTotalAllocatedBytes()
+{
+	ScopedMutex scopedMutex(this->mutex);
+	return this->allocatedSize;
+}
+
+void TrackingAllocator::writeTopSites(StringStream& stringStream, uint32_t count, SortBy::Enum sortBy)
+{
+	using namespace TrackingAllocatorInternalFn;
+
+	// Symbols are resolved outside the lock, on a copy of the sites
+	CallSite* topSiteList = (CallSite*)this->backingAllocator.allocate(count * sizeof(CallSite), alignof(CallSite));
+	const uint32_t topCount = collectTopSites(*this, topSiteList, count, sortBy);
+
+	for (uint32_t i = 0; i < topCount; ++i)
+	{
+		writeSite(stringStream, i + 1, topSiteList[i]);
+	}
+
+	this->backingAllocator.deallocate(topSiteList);
+}
+
+void TrackingAllocator::logTopSites(uint32_t count, SortBy::Enum sortBy)
+{
+	using namespace TrackingAllocatorInternalFn;
+
+	CallSite* topSiteList = (CallSite*)this->backingAllocator.allocate(count * sizeof(CallSite), alignof(CallSite));
+	const uint32_t topCount = collectTopSites(*this, topSiteList, count, sortBy);
+
+	// One message per site, a whole report would not fit in a log message
+	// The stream uses the backing allocator, the scratch allocator may be gone at shutdown
+	StringStream stringStream(this->backingAllocator);
+	for (uint32_t i = 0; i < topCount; ++i)
+	{
+		ArrayFn::clear(stringStream);
+		writeSite(stringStream, i + 1, topSiteList[i]);
+		ArrayFn::popBack(stringStream); // The log adds its own newline
+		LogInternal::logExtended(LogSeverity::LOG_INFO, MEMORY, "%s", StringStreamFn::getCStr(stringStream));
+	}
+
+	this->backingAllocator.deallocate(topSiteList);
+}
+
+} // namespace Rio
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Core/Memory/Allocator.h"
+#include "Core/Strings/Types.h"
+#include "Core/Thread/Mutex.h"
+
+namespace Rio
+{
+
+// Records the call stack of every allocation made through the backing allocator
+// Allocations are grouped by call site, each keeping its live bytes and count
+// as well as the number of allocations made since startup, which shows allocation churn
+// The sites holding the most memory, or allocating the most often, can be reported at any time
+// and are logged when the allocator is destroyed with allocations still alive
+struct TrackingAllocator : public Allocator
+{
+	static const uint32_t MAX_FRAME_COUNT = 8;
+	static const uint32_t MAX_SITE_COUNT = 4096; // Must be a power of two
+	static const uint32_t OVERFLOW_SITE_INDEX = MAX_SITE_COUNT; // Collects allocations once all sites are taken
+
+	struct SortBy
+	{
+		enum Enum
+		{
+			LIVE_BYTES,
+			ALLOCATION_COUNT
+		};
+	};
+
+	struct CallSite
+	{
+		uint32_t hash; // 0 when the site is not used
+		uint32_t frameCount;
+		void* frameList[MAX_FRAME_COUNT];
+
+		uint32_t allocatedSize;
+		uint32_t allocationCount;
+		uint64_t totalAllocationCount;
+	};
+
+	// Header stored in front of the data of every block
+	// <size> must be the last member, it is the word before the data when there is no padding
+	struct Header
+	{
+		uint32_t siteIndex;
+		uint32_t size;
+	};
+
+	Allocator& backingAllocator;
+	Mutex mutex; // Protects the call site table
+	CallSite* siteList = nullptr; // MAX_SITE_COUNT sites plus the overflow site
+	uint32_t siteCount = 0;
+	uint32_t allocatedSize = 0;
+	uint32_t allocationCount = 0;
+
+	TrackingAllocator(Allocator& backing);
+	~TrackingAllocator();
+
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	void deallocate(void* data);
+	void* reallocate(void* data, uint32_t usedSize, uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+	uint32_t getAllocatedSize(const void* ptr);
+	uint32_t getTotalAllocatedBytes();
+
+	// Writes the <count> call sites with the highest <sortBy> value to <stringStream>, together with their call stacks
+	void writeTopSites(StringStream& stringStream, uint32_t count, SortBy::Enum sortBy);
+
+	// Logs the report written by writeTopSites()
+	void logTopSites(uint32_t count, SortBy::Enum sortBy);
+};
+
+} // namespace Rio
@@ -0,0 +1,169 @@
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/VirtualArenaAllocator.h"
+#include "Core/Platform.h"
+
+#if RIO_PLATFORM_POSIX
+	#include <errno.h>
+	#include <sys/mman.h> // mmap, mprotect, madvise
+	#include <unistd.h> // sysconf
+#elif RIO_PLATFORM_WINDOWS
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#endif
+
+namespace Rio
+{
+
+namespace VirtualArenaAllocatorInternalFn
+{
+	inline uint32_t getPageSize()
+	{
+#if RIO_PLATFORM_POSIX
+		return (uint32_t)sysconf(_SC_PAGESIZE);
+#elif RIO_PLATFORM_WINDOWS
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo(&systemInfo);
+		return (uint32_t)systemInfo.dwPageSize;
+#endif
+	}
+
+	inline uint32_t roundUp(uint32_t size, uint32_t granularity)
+	{
+		return ((size + granularity - 1) / granularity) * granularity;
+	}
+
+	inline char* reserve(uint32_t size)
+	{
+#if RIO_PLATFORM_POSIX
+		void* p = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		RIO_ASSERT(p != MAP_FAILED, "mmap: errno = %d", errno);
+		return p == MAP_FAILED ? nullptr : (char*)p;
+#elif RIO_PLATFORM_WINDOWS
+		void* p = VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+		RIO_ASSERT(p != nullptr, "VirtualAlloc: GetLastError = %d", GetLastError());
+		return (char*)p;
+#endif
+	}
+
+	inline void release(char* p, uint32_t size)
+	{
+#if RIO_PLATFORM_POSIX
+		int err = munmap(p, size);
+		RIO_ASSERT(err == 0, "munmap: errno = %d", errno);
+		RIO_UNUSED(err);
+#elif RIO_PLATFORM_WINDOWS
+		RIO_UNUSED(size);
+		BOOL err = VirtualFree(p, 0, MEM_RELEASE);
+		RIO_ASSERT(err != 0, "VirtualFree: GetLastError = %d", GetLastError());
+		RIO_UNUSED(err);
+#endif
+	}
+
+	inline bool commit(char* p, uint32_t size)
+	{
+#if RIO_PLATFORM_POSIX
+		return mprotect(p, size, PROT_READ | PROT_WRITE) == 0;
+#elif RIO_PLATFORM_WINDOWS
+		return VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#endif
+	}
+
+	inline void decommit(char* p, uint32_t size)
+	{
+#if RIO_PLATFORM_POSIX
+		// Drop the pages first, mprotect() alone would keep them resident
+		madvise(p, size, MADV_DONTNEED);
+		mprotect(p, size, PROT_NONE);
+#elif RIO_PLATFORM_WINDOWS
+		VirtualFree(p, size, MEM_DECOMMIT);
+#endif
+	}
+
+} // namespace VirtualArenaAllocatorInternalFn
+
+VirtualArenaAllocator::VirtualArenaAllocator(uint32_t reserveSize, uint32_t commitGranularity)
+{
+	using namespace VirtualArenaAllocatorInternalFn;
+
+	const uint32_t pageSize = getPageSize();
+	this->commitGranularity = roundUp(commitGranularity, pageSize);
+	this->reservedSize = roundUp(reserveSize, this->commitGranularity);
+	this->base = reserve(this->reservedSize);
+}
+
+VirtualArenaAllocator::~VirtualArenaAllocator()
+{
+	RIO_ASSERT(this->offset == 0
+		, "Memory leak of %d bytes, maybe you forgot to call clear()?"
+		, this->offset
+		);
+
+	if (this->base)
+	{
+		VirtualArenaAllocatorInternalFn::release(this->base, this->reservedSize);
+	}
+}
+
+void* VirtualArenaAllocator::allocate(uint32_t size, uint32_t align)
+{
+	using namespace VirtualArenaAllocatorInternalFn;
+
+	if (this->base == nullptr)
+	{
+		return nullptr;
+	}
+
+	char* data = (char*)Memory::getAlignedToTop(this->base + this->offset, align);
+	const uint64_t newOffset = uint64_t(data - this->base) + size;
+
+	// Out of reserved memory
+	if (newOffset > this->reservedSize)
+	{
+		return nullptr;
+	}
+
+	if (newOffset > this->committedSize)
+	{
+		const uint32_t newCommittedSize = roundUp((uint32_t)newOffset, this->commitGranularity);
+		if (!commit(this->base + this->committedSize, newCommittedSize - this->committedSize))
+		{
+			return nullptr;
+		}
+		this->committedSize = newCommittedSize;
+	}
+
+	this->offset = (uint32_t)newOffset;
+	return data;
+}
+
+void VirtualArenaAllocator::deallocate(void* /*data*/)
+{
+	// Single deallocations not supported. Use clear() or rewind()
+}
+
+void VirtualArenaAllocator::clear()
+{
+	this->offset = 0;
+}
+
+void VirtualArenaAllocator::rewind(uint32_t marker)
+{
+	RIO_ASSERT(marker <= this->offset, "Marker %d is above the top of the arena %d", marker, this->offset);
+	this->offset = marker;
+}
+
+void VirtualArenaAllocator::decommitUnused()
+{
+	using namespace VirtualArenaAllocatorInternalFn;
+
+	const uint32_t keepSize = roundUp(this->offset, this->commitGranularity);
+	if (keepSize < this->committedSize)
+	{
+		decommit(this->base + keepSize, this->committedSize - keepSize);
+		this->committedSize = keepSize;
+	}
+}
+
+} // namespace Rio
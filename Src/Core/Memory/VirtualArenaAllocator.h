@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Core/Memory/Allocator.h"
+
+namespace Rio
+{
+
+// Allocates memory linearly from a range of virtual memory reserved up front
+// Pages are committed on demand as the arena grows, so a large range costs nothing until it is used
+// and allocations never move, unlike a growing array
+// Memory is freed all at once with clear() or back to a marker with rewind()
+struct VirtualArenaAllocator : public Allocator
+{
+	char* base = nullptr;
+	uint32_t reservedSize = 0;
+	uint32_t committedSize = 0;
+	uint32_t offset = 0;
+	uint32_t commitGranularity = 0;
+
+	// Reserves <reserveSize> bytes of address space
+	// Memory is committed in steps of <commitGranularity> bytes, rounded up to the page size
+	VirtualArenaAllocator(uint32_t reserveSize, uint32_t commitGranularity = 64 * 1024);
+	~VirtualArenaAllocator();
+
+	// Returns nullptr when the reserved range is exhausted
+	void* allocate(uint32_t size, uint32_t align = Allocator::DEFAULT_ALIGN);
+
+	// The arena does not support deallocating individual allocations
+	// You have to call clear() or rewind() to free memory
+	void deallocate(void* data);
+
+	// Frees all the allocations made by allocate()
+	// Committed pages are kept for reuse, see decommitUnused()
+	void clear();
+
+	// Returns a marker to the current top of the arena
+	uint32_t getMarker() const
+	{
+		return this->offset;
+	}
+
+	// Frees all the allocations made after getMarker() returned <marker>
+	void rewind(uint32_t marker);
+
+	// Returns the committed pages above the current top of the arena to the OS
+	void decommitUnused();
+
+	uint32_t getAllocatedSize(const void* /*ptr*/)
+	{
+		return SIZE_NOT_TRACKED;
+	}
+
+	uint32_t getTotalAllocatedBytes()
+	{
+		return this->offset;
+	}
+
+	// Returns the number of bytes backed by physical memory
+	uint32_t getCommittedBytes() const
+	{
+		return this->committedSize;
+	}
+};
+
+} // namespace Rio
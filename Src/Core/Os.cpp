@@ -18,7 +18,7 @@
 	#include <cstring> // memset
 	#include <sys/wait.h> // wait
 	#include <time.h> // clock_gettime
-	#include <unistd.h> // unlink, rmdir, getcwd, fork, execv
+	#include <unistd.h> // unlink, rmdir, getcwd, fork, execv, sysconf
 #elif RIO_PLATFORM_WINDOWS
 	#include <io.h>
 	#include <stdio.h>
@@ -74,6 +74,18 @@ namespace OsFn
 #endif
 	}
 
+	uint32_t getProcessorCount()
+	{
+#if RIO_PLATFORM_POSIX
+		const long count = sysconf(_SC_NPROCESSORS_ONLN);
+		return count > 0 ? (uint32_t)count : 1;
+#elif RIO_PLATFORM_WINDOWS
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo(&systemInfo);
+		return (uint32_t)systemInfo.dwNumberOfProcessors;
+#endif
+	}
+
 	// Opens the library at <path>
 	void* libraryOpen(const char* path)
 	{
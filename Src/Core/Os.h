@@ -34,6 +34,9 @@ namespace OsFn
 	// Suspends execution for <ms> milliseconds
 	void sleep(uint32_t ms);
 
+	// Returns the number of processors available to the process
+	uint32_t getProcessorCount();
+
 	// Opens the library at <path>
 	void* libraryOpen(const char* path);
 
@@ -22,6 +22,8 @@
 #define RIO_CPU_ENDIAN_BIG 0
 #define RIO_CPU_ENDIAN_LITTLE 0
 
+#define RIO_SIMD_SSE2 0
+
 #if defined(_MSC_VER)
 	#undef RIO_COMPILER_MSVC
 	#define RIO_COMPILER_MSVC 1
@@ -104,6 +106,11 @@
 	#define RIO_CPU_ENDIAN_LITTLE 1
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#undef RIO_SIMD_SSE2
+	#define RIO_SIMD_SSE2 1
+#endif
+
 #if RIO_COMPILER_GCC
 	#define RIO_COMPILER_NAME "GCC"
 #elif RIO_COMPILER_MSVC
@@ -16,6 +16,7 @@ namespace Rio
 struct DynamicString
 {
 	ALLOCATOR_AWARE;
+	TRIVIALLY_RELOCATABLE;
 
 	Array<char> dataArray;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Core/Functional.h"
 #include "Core/Strings/Types.h"
 #include "Core/Types.h"
 
@@ -85,18 +86,22 @@ inline bool operator<(const StringId64& a, const StringId64& b)
 template <>
 struct Hash<StringId32>
 {
+	HASH_IS_MIXED;
+
 	uint32_t operator()(const StringId32& id) const
 	{
-		return id.id;
+		return HashFn::mix(id.id);
 	}
 };
 
 template <>
 struct Hash<StringId64>
 {
+	HASH_IS_MIXED;
+
 	uint32_t operator()(const StringId64& id) const
 	{
-		return (uint32_t)id.id;
+		return HashFn::mix(id.id);
 	}
 };
 
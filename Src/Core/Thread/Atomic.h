@@ -0,0 +1,336 @@
+#pragma once
+
+#include "Core/Platform.h"
+#include "Core/Types.h"
+
+#include <string.h> // memcpy
+#include <type_traits>
+
+#if RIO_PLATFORM_WINDOWS
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#endif
+
+namespace Rio
+{
+
+// Ordering of an atomic operation with respect to the other memory accesses of the thread
+// Acquire loads pair with release stores: everything written before the store is visible after the load
+// Loads may be RELAXED, ACQUIRE or SEQ_CST, stores RELAXED, RELEASE or SEQ_CST, read-modify-write operations any of them
+struct MemoryOrder
+{
+	enum Enum
+	{
+		RELAXED,
+		ACQUIRE,
+		RELEASE,
+		ACQ_REL,
+		SEQ_CST
+	};
+};
+
+namespace AtomicInternalFn
+{
+	// Keeps the arguments of type Value<T> out of template argument deduction, so literals convert to T
+	template <typename T>
+	struct ValueType
+	{
+		using Type = T;
+	};
+
+	template <typename T> using Value = typename ValueType<T>::Type;
+
+} // namespace AtomicInternalFn
+
+// Atomic operations on 32 and 64-bit integers and on pointers, stored in plain variables
+// Read-modify-write operations are sequentially consistent unless told otherwise
+namespace AtomicFn
+{
+	template <typename T> T load(const T* value, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+	template <typename T> void store(T* value, AtomicInternalFn::Value<T> newValue, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+
+	// Sets <value> to <newValue> and returns the previous value
+	template <typename T> T exchange(T* value, AtomicInternalFn::Value<T> newValue, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+
+	// Sets <value> to <newValue> if it equals <expected>
+	// Otherwise updates <expected> with the current value and returns false
+	// <order> applies when the swap happens, a failed swap is a relaxed load
+	template <typename T> bool compareExchange(T* value, T& expected, AtomicInternalFn::Value<T> newValue, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+
+	// Adds <amount> to the integer <value> and returns the previous value
+	template <typename T> T fetchAdd(T* value, AtomicInternalFn::Value<T> amount, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+
+	// Subtracts <amount> from the integer <value> and returns the previous value
+	template <typename T> T fetchSub(T* value, AtomicInternalFn::Value<T> amount, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+
+	// Keeps the loads and stores before the fence from being reordered with the ones after it
+	// A SEQ_CST fence orders stores before loads as well
+	void fence(MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+
+	// Shorthands for the orders used most
+	template <typename T> T loadRelaxed(const T* value);
+	template <typename T> T loadAcquire(const T* value);
+	template <typename T> void storeRelaxed(T* value, AtomicInternalFn::Value<T> newValue);
+	template <typename T> void storeRelease(T* value, AtomicInternalFn::Value<T> newValue);
+	template <typename T> bool compareAndSwap(T* value, T& expected, AtomicInternalFn::Value<T> newValue);
+
+} // namespace AtomicFn
+
+// Value of type T read and written atomically, T is a 32 or 64-bit integer or a pointer
+template <typename T>
+struct Atomic
+{
+	RIO_STATIC_ASSERT(sizeof(T) == 4 || sizeof(T) == 8, "Atomic<T> needs a 32 or 64-bit type");
+	RIO_STATIC_ASSERT(std::is_integral<T>::value || std::is_pointer<T>::value, "Atomic<T> needs an integer or a pointer");
+
+	T value;
+
+	Atomic();
+	explicit Atomic(T value);
+	Atomic(const Atomic<T>&) = delete;
+	Atomic<T>& operator=(const Atomic<T>&) = delete;
+
+	T load(MemoryOrder::Enum order = MemoryOrder::SEQ_CST) const;
+	void store(T newValue, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+	T exchange(T newValue, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+	bool compareExchange(T& expected, T newValue, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+
+	// Integers only
+	T fetchAdd(T amount, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+	T fetchSub(T amount, MemoryOrder::Enum order = MemoryOrder::SEQ_CST);
+};
+
+namespace AtomicInternalFn
+{
+#if RIO_PLATFORM_WINDOWS
+	// Interlocked functions of the right width for a type of <SIZE> bytes
+	// The values are passed as integers of the same size, pointers included
+	template <uint32_t SIZE> struct Interlocked;
+
+	template <>
+	struct Interlocked<4>
+	{
+		using Bits = LONG;
+
+		static Bits exchange(volatile Bits* value, Bits newValue) { return InterlockedExchange(value, newValue); }
+		static Bits compareExchange(volatile Bits* value, Bits newValue, Bits expected) { return InterlockedCompareExchange(value, newValue, expected); }
+		static Bits exchangeAdd(volatile Bits* value, Bits amount) { return InterlockedExchangeAdd(value, amount); }
+	};
+
+	template <>
+	struct Interlocked<8>
+	{
+		using Bits = LONG64;
+
+		static Bits exchange(volatile Bits* value, Bits newValue) { return InterlockedExchange64(value, newValue); }
+		static Bits compareExchange(volatile Bits* value, Bits newValue, Bits expected) { return InterlockedCompareExchange64(value, newValue, expected); }
+		static Bits exchangeAdd(volatile Bits* value, Bits amount) { return InterlockedExchangeAdd64(value, amount); }
+	};
+
+	template <typename T>
+	inline typename Interlocked<sizeof(T)>::Bits toBits(T value)
+	{
+		typename Interlocked<sizeof(T)>::Bits bits;
+		memcpy(&bits, &value, sizeof(T));
+		return bits;
+	}
+
+	template <typename T>
+	inline T fromBits(typename Interlocked<sizeof(T)>::Bits bits)
+	{
+		T value;
+		memcpy(&value, &bits, sizeof(T));
+		return value;
+	}
+#else
+	inline int getOrder(MemoryOrder::Enum order)
+	{
+		switch (order)
+		{
+		case MemoryOrder::RELAXED: return __ATOMIC_RELAXED;
+		case MemoryOrder::ACQUIRE: return __ATOMIC_ACQUIRE;
+		case MemoryOrder::RELEASE: return __ATOMIC_RELEASE;
+		case MemoryOrder::ACQ_REL: return __ATOMIC_ACQ_REL;
+		default: return __ATOMIC_SEQ_CST;
+		}
+	}
+#endif // RIO_PLATFORM_WINDOWS
+
+} // namespace AtomicInternalFn
+
+namespace AtomicFn
+{
+	template <typename T>
+	inline T load(const T* value, MemoryOrder::Enum order)
+	{
+#if RIO_PLATFORM_WINDOWS
+		const T result = *(const volatile T*)value;
+		if (order != MemoryOrder::RELAXED)
+		{
+			MemoryBarrier();
+		}
+		return result;
+#else
+		return __atomic_load_n(value, AtomicInternalFn::getOrder(order));
+#endif
+	}
+
+	template <typename T>
+	inline void store(T* value, AtomicInternalFn::Value<T> newValue, MemoryOrder::Enum order)
+	{
+#if RIO_PLATFORM_WINDOWS
+		if (order == MemoryOrder::SEQ_CST)
+		{
+			exchange(value, newValue);
+			return;
+		}
+		if (order != MemoryOrder::RELAXED)
+		{
+			MemoryBarrier();
+		}
+		*(volatile T*)value = newValue;
+#else
+		__atomic_store_n(value, newValue, AtomicInternalFn::getOrder(order));
+#endif
+	}
+
+	template <typename T>
+	inline T exchange(T* value, AtomicInternalFn::Value<T> newValue, MemoryOrder::Enum order)
+	{
+#if RIO_PLATFORM_WINDOWS
+		using Interlocked = AtomicInternalFn::Interlocked<sizeof(T)>;
+		RIO_UNUSED(order);
+		return AtomicInternalFn::fromBits<T>(Interlocked::exchange((volatile typename Interlocked::Bits*)value, AtomicInternalFn::toBits(newValue)));
+#else
+		return __atomic_exchange_n(value, newValue, AtomicInternalFn::getOrder(order));
+#endif
+	}
+
+	template <typename T>
+	inline bool compareExchange(T* value, T& expected, AtomicInternalFn::Value<T> newValue, MemoryOrder::Enum order)
+	{
+#if RIO_PLATFORM_WINDOWS
+		using Interlocked = AtomicInternalFn::Interlocked<sizeof(T)>;
+		RIO_UNUSED(order);
+		const typename Interlocked::Bits expectedBits = AtomicInternalFn::toBits(expected);
+		const typename Interlocked::Bits previousBits = Interlocked::compareExchange((volatile typename Interlocked::Bits*)value, AtomicInternalFn::toBits(newValue), expectedBits);
+		expected = AtomicInternalFn::fromBits<T>(previousBits);
+		return previousBits == expectedBits;
+#else
+		return __atomic_compare_exchange_n(value, &expected, newValue, false, AtomicInternalFn::getOrder(order), __ATOMIC_RELAXED);
+#endif
+	}
+
+	template <typename T>
+	inline T fetchAdd(T* value, AtomicInternalFn::Value<T> amount, MemoryOrder::Enum order)
+	{
+		RIO_STATIC_ASSERT(std::is_integral<T>::value, "fetchAdd() needs an integer");
+#if RIO_PLATFORM_WINDOWS
+		using Interlocked = AtomicInternalFn::Interlocked<sizeof(T)>;
+		RIO_UNUSED(order);
+		return (T)Interlocked::exchangeAdd((volatile typename Interlocked::Bits*)value, (typename Interlocked::Bits)amount);
+#else
+		return __atomic_fetch_add(value, amount, AtomicInternalFn::getOrder(order));
+#endif
+	}
+
+	template <typename T>
+	inline T fetchSub(T* value, AtomicInternalFn::Value<T> amount, MemoryOrder::Enum order)
+	{
+		RIO_STATIC_ASSERT(std::is_integral<T>::value, "fetchSub() needs an integer");
+		return fetchAdd(value, T(T(0) - amount), order);
+	}
+
+	inline void fence(MemoryOrder::Enum order)
+	{
+#if RIO_PLATFORM_WINDOWS
+		RIO_UNUSED(order);
+		MemoryBarrier();
+#else
+		__atomic_thread_fence(AtomicInternalFn::getOrder(order));
+#endif
+	}
+
+	template <typename T>
+	inline T loadRelaxed(const T* value)
+	{
+		return load(value, MemoryOrder::RELAXED);
+	}
+
+	template <typename T>
+	inline T loadAcquire(const T* value)
+	{
+		return load(value, MemoryOrder::ACQUIRE);
+	}
+
+	template <typename T>
+	inline void storeRelaxed(T* value, AtomicInternalFn::Value<T> newValue)
+	{
+		store(value, newValue, MemoryOrder::RELAXED);
+	}
+
+	template <typename T>
+	inline void storeRelease(T* value, AtomicInternalFn::Value<T> newValue)
+	{
+		store(value, newValue, MemoryOrder::RELEASE);
+	}
+
+	template <typename T>
+	inline bool compareAndSwap(T* value, T& expected, AtomicInternalFn::Value<T> newValue)
+	{
+		return compareExchange(value, expected, newValue, MemoryOrder::SEQ_CST);
+	}
+
+} // namespace AtomicFn
+
+template <typename T>
+inline Atomic<T>::Atomic()
+	: value()
+{
+}
+
+template <typename T>
+inline Atomic<T>::Atomic(T value)
+	: value(value)
+{
+}
+
+template <typename T>
+inline T Atomic<T>::load(MemoryOrder::Enum order) const
+{
+	return AtomicFn::load(&(this->value), order);
+}
+
+template <typename T>
+inline void Atomic<T>::store(T newValue, MemoryOrder::Enum order)
+{
+	AtomicFn::store(&(this->value), newValue, order);
+}
+
+template <typename T>
+inline T Atomic<T>::exchange(T newValue, MemoryOrder::Enum order)
+{
+	return AtomicFn::exchange(&(this->value), newValue, order);
+}
+
+template <typename T>
+inline bool Atomic<T>::compareExchange(T& expected, T newValue, MemoryOrder::Enum order)
+{
+	return AtomicFn::compareExchange(&(this->value), expected, newValue, order);
+}
+
+template <typename T>
+inline T Atomic<T>::fetchAdd(T amount, MemoryOrder::Enum order)
+{
+	return AtomicFn::fetchAdd(&(this->value), amount, order);
+}
+
+template <typename T>
+inline T Atomic<T>::fetchSub(T amount, MemoryOrder::Enum order)
+{
+	return AtomicFn::fetchSub(&(this->value), amount, order);
+}
+
+} // namespace Rio
@@ -1,49 +1,42 @@
 #pragma once
 
-#include "Core/Platform.h"
-
-#if RIO_PLATFORM_WINDOWS
-	#include "Core/Types.h"
-	#ifndef WIN32_LEAN_AND_MEAN
-	#define WIN32_LEAN_AND_MEAN
-	#endif
-	#include <windows.h>
-#endif
+#include "Core/Thread/Atomic.h"
+#include "Core/Types.h"
 
 namespace Rio
 {
 
+// Sequentially consistent 32-bit signed integer, see Atomic<T> for explicit memory orders
 struct AtomicInt
 {
-#if RIO_PLATFORM_POSIX && RIO_COMPILER_GCC
-	mutable int32_t val;
-#elif RIO_PLATFORM_WINDOWS
-	mutable LONG val;
-#endif
+	Atomic<int32_t> value;
+
+	AtomicInt(int32_t value)
+		: value(value)
+	{
+	}
+
+	int32_t load() const
+	{
+		return this->value.load();
+	}
 
-	AtomicInt(int32_t val)
+	void store(int32_t value)
 	{
-		store(val);
+		this->value.store(value);
 	}
 
-	int load() const
+	// Adds <amount> and returns the previous value
+	int32_t fetchAdd(int32_t amount)
 	{
-#if RIO_PLATFORM_POSIX && RIO_COMPILER_GCC
-		__sync_fetch_and_add(&(this->val), 0);
-		return this->val;
-#elif RIO_PLATFORM_WINDOWS
-		InterlockedExchangeAdd(&(this->val), (int32_t)0);
-		return this->val;
-#endif
+		return this->value.fetchAdd(amount);
 	}
 
-	void store(int32_t val)
+	// Sets the value to <newValue> if it equals <expected>
+	// Otherwise updates <expected> with the current value and returns false
+	bool compareExchange(int32_t& expected, int32_t newValue)
 	{
-#if RIO_PLATFORM_POSIX && RIO_COMPILER_GCC
-		__sync_lock_test_and_set(&(this->val), val);
-#elif RIO_PLATFORM_WINDOWS
-		InterlockedExchange(&(this->val), val);
-#endif
+		return this->value.compareExchange(expected, newValue);
 	}
 };
 
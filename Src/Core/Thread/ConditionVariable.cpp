@@ -0,0 +1,63 @@
+#include "Core/Thread/ConditionVariable.h"
+
+#include "Core/Error/Error.h"
+
+namespace Rio
+{
+
+ConditionVariable::ConditionVariable()
+{
+#if RIO_PLATFORM_POSIX
+	int err = pthread_cond_init(&(this->condition), NULL);
+	RIO_ASSERT(err == 0, "pthread_cond_init: errno = %d", err);
+	RIO_UNUSED(err);
+#elif RIO_PLATFORM_WINDOWS
+	InitializeConditionVariable(&(this->condition));
+#endif
+}
+
+ConditionVariable::~ConditionVariable()
+{
+#if RIO_PLATFORM_POSIX
+	int err = pthread_cond_destroy(&(this->condition));
+	RIO_ASSERT(err == 0, "pthread_cond_destroy: errno = %d", err);
+	RIO_UNUSED(err);
+#endif
+}
+
+void ConditionVariable::wait(Mutex& mutex)
+{
+#if RIO_PLATFORM_POSIX
+	int err = pthread_cond_wait(&(this->condition), &(mutex.mutex));
+	RIO_ASSERT(err == 0, "pthread_cond_wait: errno = %d", err);
+	RIO_UNUSED(err);
+#elif RIO_PLATFORM_WINDOWS
+	BOOL err = SleepConditionVariableCS(&(this->condition), &(mutex.criticalSection), INFINITE);
+	RIO_ASSERT(err != 0, "SleepConditionVariableCS: GetLastError = %d", GetLastError());
+	RIO_UNUSED(err);
+#endif
+}
+
+void ConditionVariable::signal()
+{
+#if RIO_PLATFORM_POSIX
+	int err = pthread_cond_signal(&(this->condition));
+	RIO_ASSERT(err == 0, "pthread_cond_signal: errno = %d", err);
+	RIO_UNUSED(err);
+#elif RIO_PLATFORM_WINDOWS
+	WakeConditionVariable(&(this->condition));
+#endif
+}
+
+void ConditionVariable::broadcast()
+{
+#if RIO_PLATFORM_POSIX
+	int err = pthread_cond_broadcast(&(this->condition));
+	RIO_ASSERT(err == 0, "pthread_cond_broadcast: errno = %d", err);
+	RIO_UNUSED(err);
+#elif RIO_PLATFORM_WINDOWS
+	WakeAllConditionVariable(&(this->condition));
+#endif
+}
+
+} // namespace Rio
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Core/Platform.h"
+#include "Core/Thread/Mutex.h"
+
+#if RIO_PLATFORM_POSIX
+	#include <pthread.h>
+#elif RIO_PLATFORM_WINDOWS
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#endif
+
+namespace Rio
+{
+
+// Lets threads sleep until another thread changes some state protected by a mutex
+// Waits may end without a signal, so the state must be checked again in a loop
+struct ConditionVariable
+{
+#if RIO_PLATFORM_POSIX
+	pthread_cond_t condition;
+#elif RIO_PLATFORM_WINDOWS
+	CONDITION_VARIABLE condition;
+#endif
+
+	ConditionVariable();
+	~ConditionVariable();
+	ConditionVariable(const ConditionVariable&) = delete;
+	ConditionVariable& operator=(const ConditionVariable&) = delete;
+
+	// Unlocks <mutex>, sleeps until woken up and locks <mutex> again
+	// <mutex> must be locked by the calling thread
+	void wait(Mutex& mutex);
+
+	// Wakes up one of the waiting threads
+	void signal();
+
+	// Wakes up all the waiting threads
+	void broadcast();
+};
+
+} // namespace Rio
@@ -0,0 +1,33 @@
+#include "Core/Thread/Event.h"
+
+namespace Rio
+{
+
+Event::Event()
+{
+}
+
+void Event::set()
+{
+	ScopedMutex scopedMutex(this->mutex);
+
+	if (!this->isSet)
+	{
+		this->isSet = true;
+		this->conditionVariable.signal();
+	}
+}
+
+void Event::wait()
+{
+	ScopedMutex scopedMutex(this->mutex);
+
+	while (!this->isSet)
+	{
+		this->conditionVariable.wait(this->mutex);
+	}
+
+	this->isSet = false;
+}
+
+} // namespace Rio
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Core/Thread/ConditionVariable.h"
+#include "Core/Thread/Mutex.h"
+
+namespace Rio
+{
+
+// Auto-reset event
+// set() wakes up one waiting thread, or the next one to call wait() if none is waiting
+// Setting an event which is already set does nothing, so a waiter may consume several set() at once
+struct Event
+{
+	Mutex mutex;
+	ConditionVariable conditionVariable;
+	bool isSet = false;
+
+	Event();
+	Event(const Event&) = delete;
+	Event& operator=(const Event&) = delete;
+
+	void set();
+
+	// Sleeps until the event is set, then resets it
+	void wait();
+};
+
+} // namespace Rio
@@ -0,0 +1,410 @@
+#include "Core/Thread/JobSystem.h"
+
+#include "Core/Error/Error.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Os.h"
+#include "Core/Platform.h"
+#include "Core/Strings/String.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/Semaphore.h"
+#include "Core/Thread/Thread.h"
+
+#if RIO_PLATFORM_POSIX
+	#include <sched.h> // sched_yield
+#endif
+
+namespace Rio
+{
+
+namespace JobSystemInternalFn
+{
+	const uint32_t MAX_THREAD_COUNT = 64;
+	const uint32_t QUEUE_CAPACITY = 4096; // Jobs pending on a single thread, must be a power of two
+	const uint32_t QUEUE_MASK = QUEUE_CAPACITY - 1;
+	const uint32_t SPIN_COUNT = 64; // Rounds of failed steals before an idle worker goes to sleep
+	const uint32_t INVALID_THREAD_INDEX = 0xffffffffu;
+
+	struct Job
+	{
+		JobFunction function;
+		void* data;
+		JobCounter* counter;
+	};
+
+	// Jobs are stored one pointer at a time with relaxed atomics, since a thief may read a slot the owner is writing
+	struct JobSlot
+	{
+		void* function;
+		void* data;
+		void* counter;
+	};
+
+	// Chase-Lev deque
+	// <top> and <bottom> count jobs ever stolen and pushed, the owner works at the bottom and thieves take from the top
+	// When a single job is left the owner and the thieves race for it with a compare and swap on <top>
+	struct JobQueue
+	{
+		char padding0[RIO_CACHE_LINE_SIZE];
+		uint32_t top = 0; // Written by thieves and by the owner taking the last job
+		char padding1[RIO_CACHE_LINE_SIZE - sizeof(uint32_t)];
+		uint32_t bottom = 0; // Written by the owner
+		char padding2[RIO_CACHE_LINE_SIZE - sizeof(uint32_t)];
+		JobSlot slotList[QUEUE_CAPACITY];
+	};
+
+	static uint32_t threadCount = 0;
+	static JobQueue* queueList[MAX_THREAD_COUNT];
+	static Thread* threadList[MAX_THREAD_COUNT]; // The first one is the thread which called init()
+	static Semaphore wakeSemaphore;
+	static uint32_t sleepingCount = 0;
+	static uint32_t isExiting = 0;
+
+	static RIO_THREAD uint32_t threadIndex = INVALID_THREAD_INDEX;
+	static RIO_THREAD uint32_t randomState = 0;
+
+	static void storeJob(JobSlot& slot, const Job& job)
+	{
+		AtomicFn::storeRelaxed(&slot.function, (void*)job.function);
+		AtomicFn::storeRelaxed(&slot.data, job.data);
+		AtomicFn::storeRelaxed(&slot.counter, (void*)job.counter);
+	}
+
+	static void loadJob(const JobSlot& slot, Job& job)
+	{
+		job.function = (JobFunction)AtomicFn::loadRelaxed(&slot.function);
+		job.data = AtomicFn::loadRelaxed(&slot.data);
+		job.counter = (JobCounter*)AtomicFn::loadRelaxed(&slot.counter);
+	}
+
+	// Pushes <job> at the bottom of <queue>, returns false if it is full
+	// Owner only
+	static bool push(JobQueue& queue, const Job& job)
+	{
+		const uint32_t bottom = AtomicFn::loadRelaxed(&queue.bottom);
+		const uint32_t top = AtomicFn::loadAcquire(&queue.top);
+		if (bottom - top >= QUEUE_CAPACITY)
+		{
+			return false;
+		}
+
+		storeJob(queue.slotList[bottom & QUEUE_MASK], job);
+		AtomicFn::storeRelease(&queue.bottom, bottom + 1);
+		return true;
+	}
+
+	// Pops the newest job of <queue> into <job>, returns false if there is none
+	// Owner only
+	static bool pop(JobQueue& queue, Job& job)
+	{
+		const uint32_t bottom = AtomicFn::loadRelaxed(&queue.bottom) - 1;
+		AtomicFn::storeRelaxed(&queue.bottom, bottom);
+		AtomicFn::fence();
+		uint32_t top = AtomicFn::loadRelaxed(&queue.top);
+
+		const int32_t count = int32_t(bottom - top);
+		if (count < 0)
+		{
+			AtomicFn::storeRelaxed(&queue.bottom, bottom + 1);
+			return false;
+		}
+
+		loadJob(queue.slotList[bottom & QUEUE_MASK], job);
+		if (count > 0)
+		{
+			return true;
+		}
+
+		const bool isTaken = AtomicFn::compareAndSwap(&queue.top, top, top + 1);
+		AtomicFn::storeRelaxed(&queue.bottom, bottom + 1);
+		return isTaken;
+	}
+
+	// Steals the oldest job of <queue> into <job>, returns false if there is none or another thread took it first
+	static bool steal(JobQueue& queue, Job& job)
+	{
+		uint32_t top = AtomicFn::loadAcquire(&queue.top);
+		AtomicFn::fence();
+		const uint32_t bottom = AtomicFn::loadAcquire(&queue.bottom);
+		if (int32_t(bottom - top) <= 0)
+		{
+			return false;
+		}
+
+		// The slot may be overwritten by the owner as soon as <top> moves on, the copy is dropped when the swap fails
+		loadJob(queue.slotList[top & QUEUE_MASK], job);
+		return AtomicFn::compareAndSwap(&queue.top, top, top + 1);
+	}
+
+	static uint32_t getRandom()
+	{
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 17;
+		randomState ^= randomState << 5;
+		return randomState;
+	}
+
+	// Takes a job from the queue of the calling thread, or steals one from the others starting from a random one
+	static bool getJob(Job& job)
+	{
+		if (pop(*queueList[threadIndex], job))
+		{
+			return true;
+		}
+
+		const uint32_t count = threadCount;
+		const uint32_t first = getRandom() % count;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const uint32_t victim = (first + i) % count;
+			if (victim != threadIndex && steal(*queueList[victim], job))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static void execute(const Job& job)
+	{
+		job.function(job.data);
+
+		if (job.counter != nullptr)
+		{
+			AtomicFn::fetchSub(&job.counter->value, 1);
+		}
+	}
+
+	static void yield()
+	{
+#if RIO_PLATFORM_POSIX
+		sched_yield();
+#elif RIO_PLATFORM_WINDOWS
+		SwitchToThread();
+#endif
+	}
+
+	// Wakes up to <count> sleeping workers
+	// The fence orders the pushes before the read of <sleepingCount>, as a worker going to sleep
+	// increments it before looking for jobs one last time, one of the two always sees the other
+	static void wakeWorkers(uint32_t count)
+	{
+		AtomicFn::fence();
+		const uint32_t sleeping = AtomicFn::loadRelaxed(&sleepingCount);
+		if (sleeping > 0)
+		{
+			wakeSemaphore.post(count < sleeping ? count : sleeping);
+		}
+	}
+
+	static int32_t runWorker(void* data)
+	{
+		threadIndex = (uint32_t)(uintptr_t)data;
+		randomState = threadIndex * 2654435761u + 1;
+
+		uint32_t idleCount = 0;
+		while (AtomicFn::loadAcquire(&isExiting) == 0)
+		{
+			Job job;
+			if (getJob(job))
+			{
+				execute(job);
+				idleCount = 0;
+				continue;
+			}
+
+			if (++idleCount < SPIN_COUNT)
+			{
+				yield();
+				continue;
+			}
+
+			idleCount = 0;
+			AtomicFn::fetchAdd(&sleepingCount, 1);
+			if (getJob(job))
+			{
+				AtomicFn::fetchSub(&sleepingCount, 1);
+				execute(job);
+				continue;
+			}
+
+			wakeSemaphore.wait();
+			AtomicFn::fetchSub(&sleepingCount, 1);
+		}
+
+		return 0;
+	}
+
+} // namespace JobSystemInternalFn
+
+namespace JobSystemFn
+{
+	void run(JobFunction function, void* data, JobCounter* counter)
+	{
+		JobDecl jobDecl;
+		jobDecl.function = function;
+		jobDecl.data = data;
+		run(&jobDecl, 1, counter);
+	}
+
+	void run(const JobDecl* jobDeclList, uint32_t count, JobCounter* counter)
+	{
+		using namespace JobSystemInternalFn;
+
+		if (counter != nullptr)
+		{
+			AtomicFn::fetchAdd(&counter->value, count);
+		}
+
+		uint32_t i = 0;
+		if (threadIndex != INVALID_THREAD_INDEX)
+		{
+			JobQueue& queue = *queueList[threadIndex];
+			for (; i < count; ++i)
+			{
+				Job job;
+				job.function = jobDeclList[i].function;
+				job.data = jobDeclList[i].data;
+				job.counter = counter;
+				if (!push(queue, job))
+				{
+					break;
+				}
+			}
+
+			if (i > 0)
+			{
+				wakeWorkers(i);
+			}
+		}
+
+		// Runs what did not fit in the queue, or everything when the calling thread does not run jobs
+		for (; i < count; ++i)
+		{
+			Job job;
+			job.function = jobDeclList[i].function;
+			job.data = jobDeclList[i].data;
+			job.counter = counter;
+			execute(job);
+		}
+	}
+
+	void wait(JobCounter* counter)
+	{
+		using namespace JobSystemInternalFn;
+
+		while (AtomicFn::loadAcquire(&counter->value) != 0)
+		{
+			RIO_ASSERT(threadIndex != INVALID_THREAD_INDEX, "Jobs run elsewhere can only be waited on by threads running jobs");
+
+			Job job;
+			if (getJob(job))
+			{
+				execute(job);
+			}
+			else
+			{
+				yield();
+			}
+		}
+	}
+
+	uint32_t getThreadCount()
+	{
+		using namespace JobSystemInternalFn;
+		return threadCount > 0 ? threadCount : 1;
+	}
+
+	uint32_t getThreadIndex()
+	{
+		using namespace JobSystemInternalFn;
+		return threadIndex != INVALID_THREAD_INDEX ? threadIndex : 0;
+	}
+
+} // namespace JobSystemFn
+
+namespace JobSystemGlobalFn
+{
+	void init(uint32_t workerCount)
+	{
+		using namespace JobSystemInternalFn;
+
+		RIO_ASSERT(threadCount == 0, "Job system is already running");
+
+		if (workerCount == 0)
+		{
+			workerCount = OsFn::getProcessorCount() - 1;
+		}
+
+		threadCount = workerCount + 1 < MAX_THREAD_COUNT ? workerCount + 1 : MAX_THREAD_COUNT;
+		isExiting = 0;
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			queueList[i] = RIO_NEW(getDefaultAllocator(), JobQueue)();
+		}
+
+		threadIndex = 0;
+		randomState = 1;
+
+		for (uint32_t i = 1; i < threadCount; ++i)
+		{
+			threadList[i] = RIO_NEW(getDefaultAllocator(), Thread)();
+			threadList[i]->start(runWorker, (void*)(uintptr_t)i);
+
+			char name[16];
+			snPrintF(name, sizeof(name), "Job %u", i);
+			threadList[i]->setName(name);
+		}
+	}
+
+	void shutdown()
+	{
+		using namespace JobSystemInternalFn;
+
+		AtomicFn::storeRelease(&isExiting, 1);
+		wakeSemaphore.post(threadCount);
+
+		for (uint32_t i = 1; i < threadCount; ++i)
+		{
+			threadList[i]->stop();
+			RIO_DELETE(getDefaultAllocator(), threadList[i]);
+		}
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			RIO_ASSERT(queueList[i]->top == queueList[i]->bottom, "Jobs are still pending");
+			RIO_DELETE(getDefaultAllocator(), queueList[i]);
+		}
+
+		threadIndex = INVALID_THREAD_INDEX;
+		threadCount = 0;
+	}
+
+	bool setWorkerAffinity(uint64_t affinityMask)
+	{
+		using namespace JobSystemInternalFn;
+
+		bool isSet = true;
+		for (uint32_t i = 1; i < threadCount; ++i)
+		{
+			isSet = threadList[i]->setAffinity(affinityMask) && isSet;
+		}
+		return isSet;
+	}
+
+	bool setWorkerPriority(int32_t niceValue)
+	{
+		using namespace JobSystemInternalFn;
+
+		bool isSet = true;
+		for (uint32_t i = 1; i < threadCount; ++i)
+		{
+			isSet = threadList[i]->setPriority(niceValue) && isSet;
+		}
+		return isSet;
+	}
+
+} // namespace JobSystemGlobalFn
+
+} // namespace Rio
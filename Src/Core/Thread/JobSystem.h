@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace Rio
+{
+
+// Function run by a job, <data> is the pointer the job was started with
+using JobFunction = void (*)(void* data);
+
+struct JobDecl
+{
+	JobFunction function = nullptr;
+	void* data = nullptr;
+};
+
+// Number of jobs started with the counter which have not finished yet
+// A job started from another job can use the same counter or its own one, waiting on it gives fork/join
+// Must stay alive until JobSystemFn::wait() on it returns
+struct JobCounter
+{
+	uint32_t value = 0;
+};
+
+// Runs jobs on one worker thread per processor
+// Every thread running jobs owns a work-stealing deque: it pushes and pops its own jobs at the bottom,
+// idle threads steal the oldest ones from the top of the others' deques
+// Jobs can be started and waited on from the thread which called JobSystemGlobalFn::init() and from jobs,
+// on any other thread, or when the job system is not running, they run right away on the calling thread
+namespace JobSystemFn
+{
+	// Starts a job calling <function> with <data>
+	// <counter> is incremented now and decremented once the job has returned, it may be nullptr
+	void run(JobFunction function, void* data, JobCounter* counter);
+
+	// Starts <count> jobs from <jobDeclList>
+	// <counter> is incremented by <count> now and decremented once per job returned, it may be nullptr
+	void run(const JobDecl* jobDeclList, uint32_t count, JobCounter* counter);
+
+	// Runs jobs on the calling thread until <counter> reaches zero
+	void wait(JobCounter* counter);
+
+	// Returns the number of threads running jobs, the one which called JobSystemGlobalFn::init() included
+	uint32_t getThreadCount();
+
+	// Returns the index of the calling thread among those running jobs, 0 for the one which called JobSystemGlobalFn::init()
+	// Returns 0 as well for threads which do not run jobs
+	uint32_t getThreadIndex();
+
+} // namespace JobSystemFn
+
+namespace JobSystemGlobalFn
+{
+	// Starts <workerCount> worker threads, one less than the number of processors when 0
+	void init(uint32_t workerCount = 0);
+
+	// Stops the worker threads
+	// No job may be running or pending
+	void shutdown();
+
+	// Sets the affinity of all the worker threads, see Thread::setAffinity()
+	// Returns false if it was refused for any of them
+	bool setWorkerAffinity(uint64_t affinityMask);
+
+	// Sets the priority of all the worker threads, see Thread::setPriority()
+	// Returns false if it was refused for any of them
+	bool setWorkerPriority(int32_t niceValue);
+
+} // namespace JobSystemGlobalFn
+
+} // namespace Rio
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "Core/Containers/Array.h"
+#include "Core/Error/Error.h"
+#include "Core/Memory/Allocator.h"
+#include "Core/Memory/TempAllocator.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/JobSystem.h"
+
+#include <algorithm> // std::sort
+#include <new>
+
+namespace Rio
+{
+
+// Items written by the body of a parallel loop, collected in one buffer per thread running jobs
+// Every batch of items is tagged with the first index of the range which wrote it, ParallelOutputFn::merge()
+// puts the batches back in the order of their ranges, so the result is the one of a serial loop
+// however the ranges were spread over the threads
+template <typename T>
+struct ParallelOutput
+{
+	ALLOCATOR_AWARE;
+
+	struct Batch
+	{
+		uint32_t rangeBegin;
+		uint32_t bufferIndex;
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	struct Buffer
+	{
+		Array<T> itemList;
+		Array<Batch> batchList;
+		char padding[RIO_CACHE_LINE_SIZE]; // Keeps the buffers of two threads off the same cache line
+
+		Buffer(Allocator& a)
+			: itemList(a)
+			, batchList(a)
+		{
+		}
+	};
+
+	Allocator* allocator = nullptr;
+	uint32_t bufferCount = 0;
+	Buffer* bufferList = nullptr;
+	Array<Batch> mergeList;
+
+	ParallelOutput(Allocator& a);
+	ParallelOutput(const ParallelOutput<T>&) = delete;
+	~ParallelOutput();
+	ParallelOutput<T>& operator=(const ParallelOutput<T>&) = delete;
+};
+
+namespace JobSystemFn
+{
+	// Calls fn(rangeBegin, rangeEnd) on subranges of [begin, end) spread over the threads running jobs, returns once all are done
+	// A range longer than <grainSize> is split in halves: the thread splitting it keeps the first half and lets
+	// the others steal the second one, so idle threads always pick up the biggest pieces of work left
+	// When <grainSize> is 0 it is picked to give each thread a few ranges, with a single thread the loop is a single call
+	template <typename F> void parallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const F& fn);
+
+} // namespace JobSystemFn
+
+namespace ParallelOutputFn
+{
+	// Removes all the items from <o> and makes room for every thread running jobs
+	// Must be called before the loop writing to <o>
+	template <typename T> void clear(ParallelOutput<T>& o);
+
+	// Appends <item> written by the range starting at <rangeBegin> to the buffer of the calling thread
+	template <typename T> void write(ParallelOutput<T>& o, uint32_t rangeBegin, const T& item);
+
+	// Appends the items of all the threads to <itemList>, in the order of the ranges which wrote them
+	template <typename T> void merge(ParallelOutput<T>& o, Array<T>& itemList);
+
+} // namespace ParallelOutputFn
+
+namespace ParallelForInternalFn
+{
+	const uint32_t RANGES_PER_THREAD = 4;
+
+	struct Range
+	{
+		void* context;
+		uint32_t begin;
+		uint32_t end;
+	};
+
+	template <typename F>
+	struct Context
+	{
+		const F* fn;
+		uint32_t grainSize;
+		Range* rangeList;
+		uint32_t rangeCapacity;
+		uint32_t rangeCount;
+		JobCounter counter;
+	};
+
+	template <typename F>
+	void runRange(void* data)
+	{
+		const Range& range = *(Range*)data;
+		Context<F>& context = *(Context<F>*)range.context;
+
+		const uint32_t begin = range.begin;
+		uint32_t end = range.end;
+		while (end - begin > context.grainSize)
+		{
+			const uint32_t middle = begin + (end - begin) / 2;
+
+			const uint32_t index = AtomicFn::fetchAdd(&context.rangeCount, 1);
+			RIO_ASSERT(index < context.rangeCapacity, "Too many ranges");
+
+			Range& secondHalf = context.rangeList[index];
+			secondHalf.context = &context;
+			secondHalf.begin = middle;
+			secondHalf.end = end;
+			JobSystemFn::run(runRange<F>, &secondHalf, &context.counter);
+
+			end = middle;
+		}
+
+		(*context.fn)(begin, end);
+	}
+
+	template <typename T>
+	struct CompareBatch
+	{
+		bool operator()(const typename ParallelOutput<T>::Batch& a, const typename ParallelOutput<T>::Batch& b) const
+		{
+			return a.rangeBegin < b.rangeBegin;
+		}
+	};
+
+} // namespace ParallelForInternalFn
+
+namespace JobSystemFn
+{
+	template <typename F>
+	inline void parallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const F& fn)
+	{
+		using namespace ParallelForInternalFn;
+
+		if (begin >= end)
+		{
+			return;
+		}
+
+		const uint32_t count = end - begin;
+		if (grainSize == 0)
+		{
+			const uint32_t threadCount = JobSystemFn::getThreadCount();
+			grainSize = threadCount > 1 ? count / (threadCount * RANGES_PER_THREAD) : count;
+			grainSize = grainSize > 0 ? grainSize : 1;
+		}
+
+		if (count <= grainSize)
+		{
+			fn(begin, end);
+			return;
+		}
+
+		// Halving never leaves a range shorter than half the grain size
+		TempAllocator1024 ta;
+		Context<F> context;
+		context.fn = &fn;
+		context.grainSize = grainSize;
+		context.rangeCapacity = 2 * (count / grainSize) + 2;
+		context.rangeList = (Range*)ta.allocate(context.rangeCapacity * sizeof(Range), alignof(Range));
+		context.rangeCount = 0;
+
+		Range range;
+		range.context = &context;
+		range.begin = begin;
+		range.end = end;
+		runRange<F>(&range);
+
+		JobSystemFn::wait(&context.counter);
+
+		ta.deallocate(context.rangeList);
+	}
+
+} // namespace JobSystemFn
+
+namespace ParallelOutputFn
+{
+	template <typename T>
+	inline void clear(ParallelOutput<T>& o)
+	{
+		using Buffer = typename ParallelOutput<T>::Buffer;
+
+		const uint32_t threadCount = JobSystemFn::getThreadCount();
+		if (o.bufferCount != threadCount)
+		{
+			for (uint32_t i = 0; i < o.bufferCount; ++i)
+			{
+				o.bufferList[i].~Buffer();
+			}
+			o.allocator->deallocate(o.bufferList);
+
+			o.bufferList = (Buffer*)o.allocator->allocate(threadCount * sizeof(Buffer), alignof(Buffer));
+			for (uint32_t i = 0; i < threadCount; ++i)
+			{
+				new (&o.bufferList[i]) Buffer(*o.allocator);
+			}
+			o.bufferCount = threadCount;
+		}
+
+		for (uint32_t i = 0; i < o.bufferCount; ++i)
+		{
+			ArrayFn::clear(o.bufferList[i].itemList);
+			ArrayFn::clear(o.bufferList[i].batchList);
+		}
+	}
+
+	template <typename T>
+	inline void write(ParallelOutput<T>& o, uint32_t rangeBegin, const T& item)
+	{
+		const uint32_t threadIndex = JobSystemFn::getThreadIndex();
+		RIO_ASSERT(threadIndex < o.bufferCount, "ParallelOutputFn::clear() was not called");
+
+		typename ParallelOutput<T>::Buffer& buffer = o.bufferList[threadIndex];
+		const uint32_t batchCount = ArrayFn::getCount(buffer.batchList);
+		if (batchCount == 0 || buffer.batchList[batchCount - 1].rangeBegin != rangeBegin)
+		{
+			typename ParallelOutput<T>::Batch batch;
+			batch.rangeBegin = rangeBegin;
+			batch.bufferIndex = threadIndex;
+			batch.offset = ArrayFn::getCount(buffer.itemList);
+			batch.count = 0;
+			ArrayFn::pushBack(buffer.batchList, batch);
+		}
+
+		ArrayFn::pushBack(buffer.itemList, item);
+		++buffer.batchList[ArrayFn::getCount(buffer.batchList) - 1].count;
+	}
+
+	template <typename T>
+	inline void merge(ParallelOutput<T>& o, Array<T>& itemList)
+	{
+		using Batch = typename ParallelOutput<T>::Batch;
+
+		ArrayFn::clear(o.mergeList);
+		for (uint32_t i = 0; i < o.bufferCount; ++i)
+		{
+			const Array<Batch>& batchList = o.bufferList[i].batchList;
+			ArrayFn::push(o.mergeList, ArrayFn::begin(batchList), ArrayFn::getCount(batchList));
+		}
+
+		std::sort(ArrayFn::begin(o.mergeList), ArrayFn::end(o.mergeList), ParallelForInternalFn::CompareBatch<T>());
+
+		for (uint32_t i = 0; i < ArrayFn::getCount(o.mergeList); ++i)
+		{
+			const Batch& batch = o.mergeList[i];
+			const Array<T>& bufferItemList = o.bufferList[batch.bufferIndex].itemList;
+			ArrayFn::push(itemList, ArrayFn::begin(bufferItemList) + batch.offset, batch.count);
+		}
+	}
+
+} // namespace ParallelOutputFn
+
+template <typename T>
+inline ParallelOutput<T>::ParallelOutput(Allocator& a)
+	: allocator(&a)
+	, mergeList(a)
+{
+}
+
+template <typename T>
+inline ParallelOutput<T>::~ParallelOutput()
+{
+	for (uint32_t i = 0; i < this->bufferCount; ++i)
+	{
+		this->bufferList[i].~Buffer();
+	}
+	this->allocator->deallocate(this->bufferList);
+}
+
+} // namespace Rio
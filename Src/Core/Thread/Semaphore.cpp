@@ -7,11 +7,7 @@ namespace Rio
 
 Semaphore::Semaphore()
 {
-#if RIO_PLATFORM_POSIX
-	int err = pthread_cond_init(&(this->cond), NULL);
-	RIO_ASSERT(err == 0, "pthread_cond_init: errno = %d", err);
-	RIO_UNUSED(err);
-#elif RIO_PLATFORM_WINDOWS
+#if RIO_PLATFORM_WINDOWS
 	this->handle = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
 	RIO_ASSERT(this->handle != nullptr, "CreateSemaphore: GetLastError = %d", GetLastError());
 	RIO_UNUSED(this->handle);
@@ -20,11 +16,7 @@ Semaphore::Semaphore()
 
 Semaphore::~Semaphore()
 {
-#if RIO_PLATFORM_POSIX
-	int err = pthread_cond_destroy(&(this->cond));
-	RIO_ASSERT(err == 0, "pthread_cond_destroy: errno = %d", err);
-	RIO_UNUSED(err);
-#elif RIO_PLATFORM_WINDOWS
+#if RIO_PLATFORM_WINDOWS
 	BOOL err = CloseHandle(this->handle);
 	RIO_ASSERT(err != 0, "CloseHandle: GetLastError = %d", GetLastError());
 	RIO_UNUSED(err);
@@ -38,9 +30,7 @@ void Semaphore::post(uint32_t count)
 
 	for (uint32_t i = 0; i < count; ++i)
 	{
-		int err = pthread_cond_signal(&(this->cond));
-		RIO_ASSERT(err == 0, "pthread_cond_signal: errno = %d", err);
-		RIO_UNUSED(err);
+		this->condition.signal();
 	}
 
 	this->count += count;
@@ -58,9 +48,7 @@ void Semaphore::wait()
 
 	while (this->count <= 0)
 	{
-		int err = pthread_cond_wait(&(this->cond), &(this->mutex.mutex));
-		RIO_ASSERT(err == 0, "pthread_cond_wait: errno = %d", err);
-		RIO_UNUSED(err);
+		this->condition.wait(this->mutex);
 	}
 
 	this->count--;
@@ -1,11 +1,10 @@
 #pragma once
 
 #include "Core/Platform.h"
+#include "Core/Thread/ConditionVariable.h"
 #include "Core/Thread/Mutex.h"
 
-#if RIO_PLATFORM_POSIX
-	#include <pthread.h>
-#elif RIO_PLATFORM_WINDOWS
+#if RIO_PLATFORM_WINDOWS
 	#ifndef WIN32_LEAN_AND_MEAN
 	#define WIN32_LEAN_AND_MEAN
 	#endif
@@ -21,7 +20,7 @@ struct Semaphore
 
 #if RIO_PLATFORM_POSIX
 	Mutex mutex;
-	pthread_cond_t condition;
+	ConditionVariable condition;
 	int32_t count = 0;
 #elif RIO_PLATFORM_WINDOWS
 	HANDLE handle = INVALID_HANDLE_VALUE;
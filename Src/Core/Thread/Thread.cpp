@@ -2,15 +2,119 @@
 
 #include "Core/Error/Error.h"
 
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	#include <sched.h> // sched_setaffinity
+	#include <string.h> // strncpy
+	#include <sys/resource.h> // setpriority
+	#include <sys/syscall.h> // SYS_gettid
+	#include <unistd.h> // syscall
+#endif
+
 namespace Rio
 {
 
+namespace ThreadInternalFn
+{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	static int32_t getCurrentSystemId()
+	{
+		return (int32_t)syscall(SYS_gettid);
+	}
+
+	static void setName(pthread_t handle, const char* name)
+	{
+		// Names longer than 15 characters are refused, not truncated
+		char shortName[16];
+		strncpy(shortName, name, sizeof(shortName) - 1);
+		shortName[sizeof(shortName) - 1] = '\0';
+
+		int err = pthread_setname_np(handle, shortName);
+		RIO_ASSERT(err == 0, "pthread_setname_np: errno = %d", err);
+		RIO_UNUSED(err);
+	}
+
+	static bool setAffinity(int32_t systemId, uint64_t affinityMask)
+	{
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		for (uint32_t i = 0; i < CPU_SETSIZE; ++i)
+		{
+			if (affinityMask == 0 || (i < 64 && (affinityMask & (uint64_t(1) << i)) != 0))
+			{
+				CPU_SET(i, &cpuSet);
+			}
+		}
+
+		return sched_setaffinity(systemId, sizeof(cpuSet), &cpuSet) == 0;
+	}
+
+	static bool setPriority(int32_t systemId, int32_t niceValue)
+	{
+		return setpriority(PRIO_PROCESS, (id_t)systemId, niceValue) == 0;
+	}
+#elif RIO_PLATFORM_WINDOWS
+	using SetThreadDescriptionFunction = HRESULT (WINAPI*)(HANDLE thread, PCWSTR threadDescription);
+
+	static void setName(HANDLE handle, const char* name)
+	{
+		// SetThreadDescription() only exists since Windows 10
+		SetThreadDescriptionFunction setThreadDescription = (SetThreadDescriptionFunction)GetProcAddress(GetModuleHandleA("kernel32.dll"), "SetThreadDescription");
+		if (setThreadDescription == nullptr)
+		{
+			return;
+		}
+
+		WCHAR wideName[64];
+		if (MultiByteToWideChar(CP_UTF8, 0, name, -1, wideName, 64) != 0)
+		{
+			setThreadDescription(handle, wideName);
+		}
+	}
+
+	static bool setAffinity(HANDLE handle, uint64_t affinityMask)
+	{
+		DWORD_PTR threadMask = (DWORD_PTR)affinityMask;
+		if (affinityMask == 0)
+		{
+			DWORD_PTR systemMask;
+			GetProcessAffinityMask(GetCurrentProcess(), &threadMask, &systemMask);
+		}
+
+		return SetThreadAffinityMask(handle, threadMask) != 0;
+	}
+
+	static bool setPriority(HANDLE handle, int32_t niceValue)
+	{
+		int priority = THREAD_PRIORITY_NORMAL;
+		if (niceValue <= -15)
+		{
+			priority = THREAD_PRIORITY_HIGHEST;
+		}
+		else if (niceValue < 0)
+		{
+			priority = THREAD_PRIORITY_ABOVE_NORMAL;
+		}
+		else if (niceValue >= 15)
+		{
+			priority = THREAD_PRIORITY_LOWEST;
+		}
+		else if (niceValue > 0)
+		{
+			priority = THREAD_PRIORITY_BELOW_NORMAL;
+		}
+
+		return SetThreadPriority(handle, priority) != 0;
+	}
+#endif
+
+} // namespace ThreadInternalFn
+
 #if RIO_PLATFORM_POSIX
 static void* threadProcedure(void* arg)
 {
-	static int32_t result = -1;
-	result = ((Thread*)arg)->run();
-	return (void*)&result;
+	// The result travels in the pointer itself, a shared static written by every thread would be a data race
+	const int32_t result = ((Thread*)arg)->run();
+	return (void*)(intptr_t)result;
 }
 #elif RIO_PLATFORM_WINDOWS
 static DWORD WINAPI threadProcedure(void* arg)
@@ -89,10 +193,93 @@ bool Thread::isThreadRunning()
 	return isRunning;
 }
 
+void Thread::setName(const char* name)
+{
+	RIO_ASSERT(isRunning, "Thread is not running");
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID || RIO_PLATFORM_WINDOWS
+	ThreadInternalFn::setName(handle, name);
+#else
+	// Other systems only let a thread name itself
+	RIO_UNUSED(name);
+#endif
+}
+
+bool Thread::setAffinity(uint64_t affinityMask)
+{
+	RIO_ASSERT(isRunning, "Thread is not running");
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	return ThreadInternalFn::setAffinity(systemId, affinityMask);
+#elif RIO_PLATFORM_WINDOWS
+	return ThreadInternalFn::setAffinity(handle, affinityMask);
+#else
+	RIO_UNUSED(affinityMask);
+	return false;
+#endif
+}
+
+bool Thread::setPriority(int32_t niceValue)
+{
+	RIO_ASSERT(isRunning, "Thread is not running");
+
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	return ThreadInternalFn::setPriority(systemId, niceValue);
+#elif RIO_PLATFORM_WINDOWS
+	return ThreadInternalFn::setPriority(handle, niceValue);
+#else
+	RIO_UNUSED(niceValue);
+	return false;
+#endif
+}
+
 int32_t Thread::run()
 {
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+	systemId = ThreadInternalFn::getCurrentSystemId();
+#endif
+
 	semaphore.post();
 	return threadFunction(userData);
 }
 
+namespace ThreadFn
+{
+	void setCurrentName(const char* name)
+	{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+		ThreadInternalFn::setName(pthread_self(), name);
+#elif RIO_PLATFORM_WINDOWS
+		ThreadInternalFn::setName(GetCurrentThread(), name);
+#else
+		pthread_setname_np(name);
+#endif
+	}
+
+	bool setCurrentAffinity(uint64_t affinityMask)
+	{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+		return ThreadInternalFn::setAffinity(ThreadInternalFn::getCurrentSystemId(), affinityMask);
+#elif RIO_PLATFORM_WINDOWS
+		return ThreadInternalFn::setAffinity(GetCurrentThread(), affinityMask);
+#else
+		RIO_UNUSED(affinityMask);
+		return false;
+#endif
+	}
+
+	bool setCurrentPriority(int32_t niceValue)
+	{
+#if RIO_PLATFORM_LINUX || RIO_PLATFORM_ANDROID
+		return ThreadInternalFn::setPriority(ThreadInternalFn::getCurrentSystemId(), niceValue);
+#elif RIO_PLATFORM_WINDOWS
+		return ThreadInternalFn::setPriority(GetCurrentThread(), niceValue);
+#else
+		RIO_UNUSED(niceValue);
+		return false;
+#endif
+	}
+
+} // namespace ThreadFn
+
 } // namespace Rio
@@ -27,6 +27,7 @@ struct Thread
 	bool isRunning = false;
 #if RIO_PLATFORM_POSIX
 	pthread_t handle = 0;
+	int32_t systemId = 0; // Kernel id of the thread on Linux, which takes affinity and priority per thread by this id
 #elif RIO_PLATFORM_WINDOWS
 	HANDLE handle = INVALID_HANDLE_VALUE;
 #endif // RIO_PLATFORM_POSIX | RIO_PLATFORM_WINDOWS
@@ -39,8 +40,31 @@ struct Thread
 	void start(ThreadFunction threadFunction, void* userData = nullptr, uint32_t stackSize = 0);
 	void stop();
 	bool isThreadRunning();
+
+	// Sets the name shown by debuggers and profilers, Linux keeps only the first 15 characters
+	// The thread must be running
+	void setName(const char* name);
+
+	// Restricts the thread to the processors whose bit is set in <affinityMask>, 0 allows all of them
+	// Returns false if the system refused it, for instance when none of the processors can be used
+	bool setAffinity(uint64_t affinityMask);
+
+	// Sets the scheduling priority as a nice value, from -20 (highest) to 19 (lowest), 0 being the default
+	// Returns false if the system refused it, raising the priority usually needs privileges on Linux
+	bool setPriority(int32_t niceValue);
+
 	// Do not call explicitly
 	int32_t run();
 };
 
+// Same as the Thread settings, for the calling thread
+// Useful for the threads not started through a Thread, such as the main thread
+namespace ThreadFn
+{
+	void setCurrentName(const char* name);
+	bool setCurrentAffinity(uint64_t affinityMask);
+	bool setCurrentPriority(int32_t niceValue);
+
+} // namespace ThreadFn
+
 } // namespace Rio
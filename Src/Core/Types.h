@@ -26,8 +26,11 @@
 
 #if defined(__GNUC__)
 	#define RIO_THREAD __thread
+	#define RIO_PREFETCH(address) __builtin_prefetch(address)
 #elif defined(_MSC_VER)
+	#include <intrin.h> // _mm_prefetch
 	#define RIO_THREAD __declspec(thread)
+	#define RIO_PREFETCH(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
 #else
 	#error "Compiler not supported"
 #endif
@@ -1,6 +1,8 @@
 #include "Device/BootConfig.h"
 
+#include "Core/Containers/Array.h"
 #include "Core/Containers/Map.h"
+#include "Core/Error/Error.h"
 #include "Core/Json/JsonObject.h"
 #include "Core/Json/RJson.h"
 #include "Core/Memory/TempAllocator.h"
@@ -10,6 +12,37 @@
 namespace Rio
 {
 
+namespace BootConfigInternalFn
+{
+	// Reads { affinity = [ 0 1 ... ] priority = 10 }, affinity lists the processors the thread may run on
+	static void parseThreadConfig(const char* json, BootThreadConfig& threadConfig)
+	{
+		TempAllocator1024 tempAllocator1024;
+		JsonObject thread(tempAllocator1024);
+		RJsonFn::parse(json, thread);
+
+		if (JsonObjectFn::has(thread, "affinity"))
+		{
+			JsonArray affinity(tempAllocator1024);
+			RJsonFn::parseArray(thread["affinity"], affinity);
+
+			threadConfig.affinityMask = 0;
+			for (uint32_t i = 0; i < ArrayFn::getCount(affinity); ++i)
+			{
+				const int32_t processor = RJsonFn::parseInt32(affinity[i]);
+				RIO_ASSERT(processor >= 0 && processor < 64, "Processor index out of range: %d", processor);
+				threadConfig.affinityMask |= uint64_t(1) << processor;
+			}
+		}
+		if (JsonObjectFn::has(thread, "priority"))
+		{
+			threadConfig.niceValue = RJsonFn::parseInt32(thread["priority"]);
+			RIO_ASSERT(threadConfig.niceValue >= -20 && threadConfig.niceValue <= 19, "Priority out of range: %d", threadConfig.niceValue);
+		}
+	}
+
+} // namespace BootConfigInternalFn
+
 BootConfig::BootConfig(Allocator& a)
 	: windowTitle(a)
 {
@@ -66,6 +99,25 @@ bool BootConfig::parse(const char* json)
 				isFullscreen = RJsonFn::parseBool(renderer["fullscreen"]);
 			}
 		}
+
+		if (JsonObjectFn::has(platform, "threads"))
+		{
+			JsonObject threads(tempAllocator4096);
+			RJsonFn::parse(platform["threads"], threads);
+
+			if (JsonObjectFn::has(threads, "main"))
+			{
+				BootConfigInternalFn::parseThreadConfig(threads["main"], mainThread);
+			}
+			if (JsonObjectFn::has(threads, "resourceLoader"))
+			{
+				BootConfigInternalFn::parseThreadConfig(threads["resourceLoader"], resourceLoaderThread);
+			}
+			if (JsonObjectFn::has(threads, "jobs"))
+			{
+				BootConfigInternalFn::parseThreadConfig(threads["jobs"], jobThread);
+			}
+		}
 	}
 
 	return true;
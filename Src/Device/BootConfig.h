@@ -9,6 +9,13 @@
 namespace Rio
 {
 
+// Settings of one of the engine threads, the defaults leave the ones inherited from the process untouched
+struct BootThreadConfig
+{
+	uint64_t affinityMask = 0; // One bit per processor the thread may run on, 0 for no change
+	int32_t niceValue = 0; // From -20 (highest priority) to 19 (lowest), 0 for no change
+};
+
 struct BootConfig
 {
 #if AMSTEL_ENGINE_SCRIPT_LUA
@@ -26,6 +33,10 @@ struct BootConfig
 	bool vSync = true;
 	bool isFullscreen = false;
 
+	BootThreadConfig mainThread;
+	BootThreadConfig resourceLoaderThread;
+	BootThreadConfig jobThread;
+
 	BootConfig(Allocator& a);
 	bool parse(const char* json);
 };
@@ -28,6 +28,9 @@
 #include "Core/Strings/String.h"
 #include "Core/Strings/StringStream.h"
 
+#include "Core/Thread/JobSystem.h"
+#include "Core/Thread/Thread.h"
+
 #include "Core/ConsoleServer.h"
 #include "Core/Profiler.h"
 
@@ -94,7 +97,10 @@
 
 #include "RioCore/Memory/Allocator.h"
 
-#define MAX_SUBSYSTEMS_HEAP 8 * 1024 * 1024
+// Address space reserved for the subsystems, pages are committed as they are used
+#define MAX_SUBSYSTEMS_HEAP 256 * 1024 * 1024
+// Address space reserved for each half of the frame allocator
+#define MAX_FRAME_HEAP 64 * 1024 * 1024
 
 namespace 
 { 
@@ -241,10 +247,23 @@ static void executeConsoleCommand(ConsoleServer& consoleServer, TcpSocket client
 
 		((Device*)userData)->reload(ResourceId(typeString.getCStr()), ResourceId(nameString.getCStr()));
 	}
+	else if (commandString == "memory")
+	{
+		StringStream stringStream(tempAllocator4096);
+		stringStream << "{\"type\":\"memory\",\"proxyAllocatorList\":";
+		ProxyAllocatorFn::writeJsonSnapshot(stringStream);
+		stringStream << "}";
+		consoleServer.send(client, StringStreamFn::getCStr(stringStream));
+	}
+	else if (commandString == "allocation_sites")
+	{
+		MemoryGlobalFn::logAllocationSites(10);
+	}
 }
 
 Device::Device(const DeviceOptions& deviceOptions, ConsoleServer& consoleServer)
-	: linearAllocator(getDefaultAllocator(), MAX_SUBSYSTEMS_HEAP)
+	: linearAllocator(MAX_SUBSYSTEMS_HEAP)
+	, frameAllocator(MAX_FRAME_HEAP)
 	, deviceOptions(deviceOptions)
 	, bootConfiguration(getDefaultAllocator())
 	, consoleServer(&consoleServer)
@@ -387,6 +406,8 @@ void Device::run()
 
 	ProfilerGlobalFn::init();
 
+	JobSystemGlobalFn::init();
+
 	resourceLoader = RIO_NEW(linearAllocator, ResourceLoader)(*dataFileSystem);
 
 	resourceManager = RIO_NEW(linearAllocator, ResourceManager)(*resourceLoader);
@@ -437,6 +458,39 @@ void Device::run()
 		resourceManager->unload(RESOURCE_TYPE_CONFIG, configName);
 	}
 
+	// Thread settings, the loader and the job workers are already running since the config is read through them
+	{
+		const BootThreadConfig& mainThread = bootConfiguration.mainThread;
+		if (mainThread.affinityMask != 0 && !ThreadFn::setCurrentAffinity(mainThread.affinityMask))
+		{
+			logWarning(DEVICE, "Could not set the affinity of the main thread");
+		}
+		if (mainThread.niceValue != 0 && !ThreadFn::setCurrentPriority(mainThread.niceValue))
+		{
+			logWarning(DEVICE, "Could not set the priority of the main thread");
+		}
+
+		const BootThreadConfig& resourceLoaderThread = bootConfiguration.resourceLoaderThread;
+		if (resourceLoaderThread.affinityMask != 0 && !resourceLoader->thread.setAffinity(resourceLoaderThread.affinityMask))
+		{
+			logWarning(DEVICE, "Could not set the affinity of the resource loader thread");
+		}
+		if (resourceLoaderThread.niceValue != 0 && !resourceLoader->thread.setPriority(resourceLoaderThread.niceValue))
+		{
+			logWarning(DEVICE, "Could not set the priority of the resource loader thread");
+		}
+
+		const BootThreadConfig& jobThread = bootConfiguration.jobThread;
+		if (jobThread.affinityMask != 0 && !JobSystemGlobalFn::setWorkerAffinity(jobThread.affinityMask))
+		{
+			logWarning(DEVICE, "Could not set the affinity of the job threads");
+		}
+		if (jobThread.niceValue != 0 && !JobSystemGlobalFn::setWorkerPriority(jobThread.niceValue))
+		{
+			logWarning(DEVICE, "Could not set the priority of the job threads");
+		}
+	}
+
 	// Init all remaining subsystems
 	rioRendererAllocator = RIO_NEW(linearAllocator, RioRendererAllocator)(getDefaultAllocator());
 	rioRendererCallback = RIO_NEW(linearAllocator, RioRendererCallback)();
@@ -527,6 +581,8 @@ void Device::run()
 		const float dt = float(double(time - timeLast) / clockFrequency);
 		timeLast = time;
 
+		frameAllocator.flip();
+
 		ProfilerGlobalFn::clear();
 
 		consoleServer->update();
@@ -638,6 +694,8 @@ void Device::run()
 
 	RIO_DELETE(linearAllocator, dataFileSystem);
 
+	JobSystemGlobalFn::shutdown();
+
 	ProfilerGlobalFn::shutdown();
 
 	linearAllocator.clear();
@@ -763,6 +821,7 @@ World* Device::createWorld()
 #if AMSTEL_ENGINE_SCRIPT_LUA
 
 	World* world = RIO_NEW(getDefaultAllocator(), World)(getDefaultAllocator()
+		, this->frameAllocator
 		, *resourceManager
 		, *shaderManager
 		, *materialManager
@@ -773,6 +832,7 @@ World* Device::createWorld()
 #else
 
 	World* world = RIO_NEW(getDefaultAllocator(), World)(getDefaultAllocator()
+		, this->frameAllocator
 		, *resourceManager
 		, *shaderManager
 		, *materialManager
@@ -6,7 +6,8 @@
 #include "Core/Containers/Types.h"
 #include "Core/FileSystem/Types.h"
 #include "Core/Memory/Allocator.h"
-#include "Core/Memory/LinearAllocator.h"
+#include "Core/Memory/FrameAllocator.h"
+#include "Core/Memory/VirtualArenaAllocator.h"
 #include "Core/Strings/StringId.h"
 #include "Core/ConsoleServer.h"
 #include "Core/LogToFile.h"
@@ -40,7 +41,8 @@ struct RioRendererCallback;
 
 struct Device
 {
-	LinearAllocator linearAllocator;
+	VirtualArenaAllocator linearAllocator;
+	FrameAllocator frameAllocator;
 
 	const DeviceOptions& deviceOptions;
 	BootConfig bootConfiguration;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Core/Thread/AtomicInt.h"
+#include "Core/Containers/SpscQueue.h"
 #include "Core/Types.h"
 
 namespace Rio
@@ -83,12 +83,9 @@ union OsEvent
 // Used only to pass events from os thread to main thread
 struct DeviceEventQueue
 {
-	AtomicInt tail{0};
-	AtomicInt head{0};
+	static const uint32_t MAX_OS_EVENTS = 128;
 
-	static const int32_t MAX_OS_EVENTS = 128;
-
-	OsEvent osEventQueue[MAX_OS_EVENTS];
+	SpscQueue<OsEvent, MAX_OS_EVENTS> osEventQueue;
 
 	DeviceEventQueue()
 	{
@@ -169,32 +166,12 @@ struct DeviceEventQueue
 
 	bool pushEvent(const OsEvent& osEvent)
 	{
-		const int32_t tail = this->tail.load();
-		const int32_t tailNext = (tail + 1) % MAX_OS_EVENTS;
-
-		if (tailNext != this->head.load())
-		{
-			osEventQueue[tail] = osEvent;
-			this->tail.store(tailNext);
-			return true;
-		}
-
-		return false;
+		return SpscQueueFn::push(osEventQueue, osEvent);
 	}
 
 	bool popEvent(OsEvent& osEvent)
 	{
-		const int32_t head = this->head.load();
-
-		if (head == this->tail.load())
-		{
-			return false;
-		}
-
-		osEvent = osEventQueue[head];
-		this->head.store((head + 1) % MAX_OS_EVENTS);
-
-		return true;
+		return SpscQueueFn::pop(osEventQueue, osEvent);
 	}
 };
 
@@ -2,14 +2,16 @@
 
 #include "Config.h"
 
+#include "Core/Containers/Array.h"
 #include "Core/Containers/Queue.h"
+#include "Core/Containers/SpscQueue.h"
 #include "Core/FileSystem/File.h"
 #include "Core/FileSystem/FileSystem.h"
 #include "Core/FileSystem/Path.h"
 #include "Core/Memory/Memory.h"
 #include "Core/Memory/TempAllocator.h"
-#include "Core/Os.h"
 #include "Core/Strings/DynamicString.h"
+#include "Core/Thread/Atomic.h"
 
 namespace Rio
 {
@@ -21,15 +23,18 @@ static int32_t threadProcedure(void* thiz)
 
 ResourceLoader::ResourceLoader(FileSystem& dataFileSystem)
 	: dataFileSystem(dataFileSystem)
-	, resourceRequestQueue(getDefaultAllocator())
-	, resourceRequestLoadedQueue(getDefaultAllocator())
+	, resourceRequestPendingQueue(getDefaultAllocator())
+	, resourceRequestLoadedList(getDefaultAllocator())
 {
 	thread.start(threadProcedure, this);
+	thread.setName("ResourceLoader");
 }
 
 ResourceLoader::~ResourceLoader()
 {
-	exit = true;
+	AtomicFn::storeRelease(&exit, 1);
+	requestEvent.set();
+	loadedTakenEvent.set();
 	thread.stop();
 }
 
@@ -50,58 +55,97 @@ bool ResourceLoader::canLoad(StringId64 type, StringId64 name)
 
 void ResourceLoader::addLoadResourceRequest(const ResourceRequest& resourceRequest)
 {
-	ScopedMutex scopedMutex(mutex);
-	QueueFn::pushBack(resourceRequestQueue, resourceRequest);
+	++this->requestsCount;
+
+	// Keep the requests in order when some are already waiting
+	if (!QueueFn::getIsEmpty(resourceRequestPendingQueue) || !SpscQueueFn::push(resourceRequestQueue, resourceRequest))
+	{
+		QueueFn::pushBack(resourceRequestPendingQueue, resourceRequest);
+		return;
+	}
+
+	requestEvent.set();
 }
 
 void ResourceLoader::flush()
 {
+	// loadedEvent may be left set by a request already taken back, so the count is checked again after each wake up
 	while (getRequestsCount() != 0)
 	{
+		loadedEvent.wait();
+	}
+}
+
+void ResourceLoader::exchangeRequests()
+{
+	bool isPushed = false;
+	while (!QueueFn::getIsEmpty(resourceRequestPendingQueue) && SpscQueueFn::push(resourceRequestQueue, QueueFn::getFront(resourceRequestPendingQueue)))
+	{
+		QueueFn::popFront(resourceRequestPendingQueue);
+		isPushed = true;
+	}
+
+	if (isPushed)
+	{
+		requestEvent.set();
+	}
+
+	bool isPopped = false;
+	ResourceRequest resourceRequest;
+	while (SpscQueueFn::pop(resourceRequestLoadedQueue, resourceRequest))
+	{
+		ArrayFn::pushBack(resourceRequestLoadedList, resourceRequest);
+		--this->requestsCount;
+		isPopped = true;
+	}
+
+	if (isPopped)
+	{
+		loadedTakenEvent.set();
 	}
 }
 
 uint32_t ResourceLoader::getRequestsCount()
 {
-	ScopedMutex scopedMutex(mutex);
-	return QueueFn::getCount(resourceRequestQueue);
+	exchangeRequests();
+	return this->requestsCount;
 }
 
-void ResourceLoader::addLoaded(ResourceRequest resourceRequest)
+void ResourceLoader::addLoaded(const ResourceRequest& resourceRequest)
 {
-	ScopedMutex scopedMutex(mutexLoaded);
-	QueueFn::pushBack(resourceRequestLoadedQueue, resourceRequest);
+	// The main thread empties the queue at least once per frame
+	while (!SpscQueueFn::push(resourceRequestLoadedQueue, resourceRequest))
+	{
+		if (AtomicFn::loadAcquire(&exit) != 0)
+		{
+			return;
+		}
+
+		loadedTakenEvent.wait();
+	}
+
+	loadedEvent.set();
 }
 
 void ResourceLoader::getLoaded(Array<ResourceRequest>& loadedResourceRequest)
 {
-	ScopedMutex scopedMutex(mutexLoaded);
+	exchangeRequests();
 
-	const uint32_t loadedCount = QueueFn::getCount(resourceRequestLoadedQueue);
-	ArrayFn::reserve(loadedResourceRequest, loadedCount);
-
-	for (uint32_t i = 0; i < loadedCount; ++i)
-	{
-		ArrayFn::pushBack(loadedResourceRequest, QueueFn::getFront(resourceRequestLoadedQueue));
-		QueueFn::popFront(resourceRequestLoadedQueue);
-	}
+	ArrayFn::push(loadedResourceRequest, ArrayFn::begin(resourceRequestLoadedList), ArrayFn::getCount(resourceRequestLoadedList));
+	ArrayFn::clear(resourceRequestLoadedList);
 }
 
 int32_t ResourceLoader::run()
 {
-	while (exit == false)
+	while (AtomicFn::loadAcquire(&exit) == 0)
 	{
-		mutex.lock();
-		if (QueueFn::getIsEmpty(resourceRequestQueue))
+		ResourceRequest resourceRequest;
+		if (!SpscQueueFn::pop(resourceRequestQueue, resourceRequest))
 		{
-			mutex.unlock();
-			OsFn::sleep(16);
+			requestEvent.wait();
 			continue;
 		}
 
-		ResourceRequest resourceRequest = QueueFn::getFront(resourceRequestQueue);
-		mutex.unlock();
-
 		StringId64 mix;
 		mix.id = resourceRequest.type.id ^ resourceRequest.name.id;
 
@@ -137,12 +181,6 @@ int32_t ResourceLoader::run()
 		{
 			RIO_FATAL("No file path.getCStr() present");
 		}
-		
-		mutex.lock();
-
-		QueueFn::popFront(resourceRequestQueue);
-		
-		mutex.unlock();
 	}
 
 	return 0;
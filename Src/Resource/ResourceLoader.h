@@ -3,7 +3,7 @@
 #include "Core/Containers/Types.h"
 #include "Core/FileSystem/Types.h"
 #include "Core/Strings/StringId.h"
-#include "Core/Thread/Mutex.h"
+#include "Core/Thread/Event.h"
 #include "Core/Thread/Thread.h"
 #include "Core/Types.h"
 
@@ -23,21 +23,35 @@ struct ResourceRequest
 };
 
 // Loads resources in a background thread
+// Requests go to the loader thread and back through lock-free single producer single consumer queues
+// Each side sleeps on an event until the other one has something for it, instead of polling the queues
+// All the functions but run() must be called from the main thread
 struct ResourceLoader
 {
+	static const uint32_t QUEUE_CAPACITY = 256;
+
 	FileSystem& dataFileSystem;
 
-	Queue<ResourceRequest> resourceRequestQueue;
-	Queue<ResourceRequest> resourceRequestLoadedQueue;
+	SpscQueue<ResourceRequest, QUEUE_CAPACITY> resourceRequestQueue; // Main thread to loader thread
+	SpscQueue<ResourceRequest, QUEUE_CAPACITY> resourceRequestLoadedQueue; // Loader thread to main thread
+
+	// Main thread only
+	Queue<ResourceRequest> resourceRequestPendingQueue; // Requests which did not fit in resourceRequestQueue yet
+	Array<ResourceRequest> resourceRequestLoadedList; // Loaded requests taken from resourceRequestLoadedQueue
+	uint32_t requestsCount = 0; // Requests added and not yet taken back from resourceRequestLoadedQueue
+
+	Event requestEvent; // Set by the main thread when requests are pushed to resourceRequestQueue
+	Event loadedEvent; // Set by the loader thread when a request is pushed to resourceRequestLoadedQueue
+	Event loadedTakenEvent; // Set by the main thread when requests are popped from resourceRequestLoadedQueue
 
 	Thread thread;
-	Mutex mutex;
-	Mutex mutexLoaded;
 
-	bool exit = false;
+	uint32_t exit = 0;
 
+	// Moves pending requests to the loader thread and takes back the loaded ones
+	void exchangeRequests();
 	uint32_t getRequestsCount();
-	void addLoaded(ResourceRequest rr);
+	void addLoaded(const ResourceRequest& resourceRequest);
 
 	// Do not call explicitly
 	int32_t run();
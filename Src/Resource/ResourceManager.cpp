@@ -1,7 +1,8 @@
 #include "Resource/ResourceManager.h"
 
 #include "Core/Containers/Array.h"
-#include "Core/Containers/SortMap.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Containers/SmallArray.h"
 #include "Core/Memory/TempAllocator.h"
 #include "Core/Strings/DynamicString.h"
 
@@ -26,10 +27,15 @@ ResourceManager::ResourceManager(ResourceLoader& resourceLoader)
 
 ResourceManager::~ResourceManager()
 {
-	auto current = SortMapFn::begin(resourceMap);
-	auto end = SortMapFn::end(resourceMap);
+	auto current = HashMapFn::begin(resourceMap);
+	auto end = HashMapFn::end(resourceMap);
 	for (; current != end; ++current)
 	{
+		if (HashMapFn::getIsHole(resourceMap, current))
+		{
+			continue;
+		}
+
 		const StringId64 type = current->first.type;
 		const StringId64 name = current->first.name;
 		onResourceOffline(type, name);
@@ -45,7 +51,7 @@ void ResourceManager::load(StringId64 type, StringId64 name)
 		name 
 	};
 
-	ResourceEntry& resourceEntry = SortMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
+	ResourceEntry resourceEntry = HashMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
 
 	if (resourceEntry == ResourceEntry::NOT_FOUND)
 	{
@@ -64,7 +70,7 @@ void ResourceManager::load(StringId64 type, StringId64 name)
 		resourceTypeData.online = nullptr;
 		resourceTypeData.offline = nullptr;
 		resourceTypeData.unload = nullptr;
-		resourceTypeData = SortMapFn::get(this->resourceTypeDataMap, type, resourceTypeData);
+		resourceTypeData = HashMapFn::get(this->resourceTypeDataMap, type, resourceTypeData);
 
 		ResourceRequest resourceRequest;
 		resourceRequest.type = type;
@@ -80,6 +86,7 @@ void ResourceManager::load(StringId64 type, StringId64 name)
 	}
 
 	resourceEntry.referencesCount++;
+	HashMapFn::set(resourceMap, resourcePair, resourceEntry);
 }
 
 void ResourceManager::unload(StringId64 type, StringId64 name)
@@ -92,15 +99,25 @@ void ResourceManager::unload(StringId64 type, StringId64 name)
 		name 
 	};
 
-	ResourceEntry& resourceEntry = SortMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
+	// Unloading a resource that is not loaded would store NOT_FOUND with a wrapped around count in the map
+	RIO_ASSERT(HashMapFn::has(resourceMap, resourcePair), "Resource not loaded");
+	if (!HashMapFn::has(resourceMap, resourcePair))
+	{
+		return;
+	}
+
+	ResourceEntry resourceEntry = HashMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
 
 	if (--resourceEntry.referencesCount == 0)
 	{
 		onResourceOffline(type, name);
 		onResourceUnload(type, resourceEntry.data);
 
-		SortMapFn::remove(resourceMap, resourcePair);
-		SortMapFn::sort(resourceMap);
+		HashMapFn::remove(resourceMap, resourcePair);
+	}
+	else
+	{
+		HashMapFn::set(resourceMap, resourcePair, resourceEntry);
 	}
 }
 
@@ -112,15 +129,22 @@ void ResourceManager::reload(StringId64 type, StringId64 name)
 		name 
 	};
 
-	const ResourceEntry& resourceEntry = SortMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
+	RIO_ASSERT(HashMapFn::has(resourceMap, resourcePair), "Resource not loaded");
+	if (!HashMapFn::has(resourceMap, resourcePair))
+	{
+		return;
+	}
+
+	const ResourceEntry& resourceEntry = HashMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
 	const uint32_t oldReferencesCount = resourceEntry.referencesCount;
 
 	unload(type, name);
 	load(type, name);
 	flush();
 
-	ResourceEntry& newResourceEntry = SortMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
+	ResourceEntry newResourceEntry = HashMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
 	newResourceEntry.referencesCount = oldReferencesCount;
+	HashMapFn::set(resourceMap, resourcePair, newResourceEntry);
 }
 
 bool ResourceManager::hasResource(StringId64 type, StringId64 name)
@@ -131,7 +155,7 @@ bool ResourceManager::hasResource(StringId64 type, StringId64 name)
 		name 
 	};
 
-	return this->autoloadEnabled ? true : SortMapFn::has(this->resourceMap, resourcePair);
+	return this->autoloadEnabled ? true : HashMapFn::has(this->resourceMap, resourcePair);
 }
 
 const void* ResourceManager::getResourceData(StringId64 type, StringId64 name)
@@ -151,13 +175,13 @@ const void* ResourceManager::getResourceData(StringId64 type, StringId64 name)
 
 	RIO_ASSERT(hasResource(type, name), "Resource not loaded #ID(%s)", path.getCStr());
 
-	if (autoloadEnabled && !SortMapFn::has(resourceMap, resourcePair))
+	if (autoloadEnabled && !HashMapFn::has(resourceMap, resourcePair))
 	{
 		load(type, name);
 		flush();
 	}
 
-	const ResourceEntry& resourceEntry = SortMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
+	const ResourceEntry& resourceEntry = HashMapFn::get(resourceMap, resourcePair, ResourceEntry::NOT_FOUND);
 	return resourceEntry.data;
 }
 
@@ -174,8 +198,7 @@ void ResourceManager::flush()
 
 void ResourceManager::completeLoadRequests()
 {
-	TempAllocator1024 tempAllocator1024;
-	Array<ResourceRequest> loadedResourceRequestList(tempAllocator1024);
+	SmallArray<ResourceRequest, 16> loadedResourceRequestList(getDefaultAllocator());
 	this->resourceLoader->getLoaded(loadedResourceRequestList);
 
 	for (uint32_t i = 0; i < ArrayFn::getCount(loadedResourceRequestList); ++i)
@@ -196,8 +219,7 @@ void ResourceManager::completeResourceLoadRequest(StringId64 type, StringId64 na
 		name 
 	};
 
-	SortMapFn::set(resourceMap, resourcePair, resourceEntry);
-	SortMapFn::sort(resourceMap);
+	HashMapFn::set(resourceMap, resourcePair, resourceEntry);
 
 	onResourceOnline(type, name);
 }
@@ -216,13 +238,12 @@ void ResourceManager::registerNewResourceType(StringId64 type, uint32_t version
 	resourceTypeData.offline = offlineFunction;
 	resourceTypeData.unload = unloadFunction;
 
-	SortMapFn::set(this->resourceTypeDataMap, type, resourceTypeData);
-	SortMapFn::sort(this->resourceTypeDataMap);
+	HashMapFn::set(this->resourceTypeDataMap, type, resourceTypeData);
 }
 
 void ResourceManager::onResourceOnline(StringId64 type, StringId64 name)
 {
-	OnlineFunction onlineFunction = SortMapFn::get(this->resourceTypeDataMap, type, ResourceTypeData()).online;
+	OnlineFunction onlineFunction = HashMapFn::get(this->resourceTypeDataMap, type, ResourceTypeData()).online;
 
 	if (onlineFunction != nullptr)
 	{
@@ -232,7 +253,7 @@ void ResourceManager::onResourceOnline(StringId64 type, StringId64 name)
 
 void ResourceManager::onResourceOffline(StringId64 type, StringId64 name)
 {
-	OfflineFunction offlineFunction = SortMapFn::get(this->resourceTypeDataMap, type, ResourceTypeData()).offline;
+	OfflineFunction offlineFunction = HashMapFn::get(this->resourceTypeDataMap, type, ResourceTypeData()).offline;
 
 	if (offlineFunction != nullptr)
 	{
@@ -242,7 +263,7 @@ void ResourceManager::onResourceOffline(StringId64 type, StringId64 name)
 
 void ResourceManager::onResourceUnload(StringId64 type, void* data)
 {
-	UnloadFunction unloadFunction = SortMapFn::get(this->resourceTypeDataMap, type, ResourceTypeData()).unload;
+	UnloadFunction unloadFunction = HashMapFn::get(this->resourceTypeDataMap, type, ResourceTypeData()).unload;
 
 	if (unloadFunction != nullptr)
 	{
@@ -2,6 +2,7 @@
 
 #include "Core/Containers/Types.h"
 #include "Core/FileSystem/Types.h"
+#include "Core/Functional.h"
 #include "Core/Memory/ProxyAllocator.h"
 #include "Core/Strings/StringId.h"
 #include "Core/Types.h"
@@ -24,9 +25,19 @@ struct ResourceManager
 		StringId64 type;
 		StringId64 name;
 
-		bool operator<(const ResourcePair& resourcePair) const
+		bool operator==(const ResourcePair& resourcePair) const
 		{
-			return type < resourcePair.type || (type == resourcePair.type && name < resourcePair.name);
+			return type == resourcePair.type && name == resourcePair.name;
+		}
+	};
+
+	struct ResourcePairHash
+	{
+		HASH_IS_MIXED;
+
+		uint32_t operator()(const ResourcePair& resourcePair) const
+		{
+			return HashFn::mix(resourcePair.type.id ^ resourcePair.name.id);
 		}
 	};
 
@@ -35,7 +46,7 @@ struct ResourceManager
 		uint32_t referencesCount = 0;
 		void* data = nullptr;
 
-		bool operator==(const ResourceEntry& resourceEntry)
+		bool operator==(const ResourceEntry& resourceEntry) const
 		{
 			return referencesCount == resourceEntry.referencesCount && data == resourceEntry.data;
 		}
@@ -52,8 +63,8 @@ struct ResourceManager
 		UnloadFunction unload = nullptr;
 	};
 
-	using ResourceTypeDataMap = SortMap<StringId64, ResourceTypeData>;
-	using ResourceMap = SortMap<ResourcePair, ResourceEntry>;
+	using ResourceTypeDataMap = HashMap<StringId64, ResourceTypeData>;
+	using ResourceMap = HashMap<ResourcePair, ResourceEntry, ResourcePairHash>;
 
 	ProxyAllocator resourceProxyAllocator;
 	ResourceLoader* resourceLoader = nullptr;
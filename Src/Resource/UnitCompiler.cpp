@@ -1,7 +1,6 @@
 #include "Resource/UnitCompiler.h"
 
 #include "Core/Containers/Array.h"
-#include "Core/Containers/Map.h"
 #include "Core/Containers/SortMap.h"
 #include "Core/Json/JsonObject.h"
 #include "Core/Json/RJson.h"
@@ -353,9 +352,7 @@ void UnitCompiler::compileUnitFromJson(const char* json)
 				const FixedString id(&key.getCStr()[1], key.getLength()-1);
 				const char* valueString = currentModifiedComponentPair->pair.second;
 
-				// TODO make better version
-				MapFn::remove(prefabRootComponentListJsonObject.jsonMap, id);
-				MapFn::set(prefabRootComponentListJsonObject.jsonMap, id, valueString);
+				JsonObjectFn::set(prefabRootComponentListJsonObject, id, valueString);
 			}
 		}
 	}
@@ -11,60 +11,11 @@
 namespace Rio
 {
 
-void LightManager::allocate(uint32_t instanceDataSize)
-{
-	RIO_ENSURE(instanceDataSize > this->lightInstanceData.size);
-
-	const uint32_t bytes = 0
-		+ instanceDataSize * sizeof(UnitId) + alignof(UnitId)
-		+ instanceDataSize * sizeof(Matrix4x4) + alignof(Matrix4x4)
-		+ instanceDataSize * sizeof(float) + alignof(float)
-		+ instanceDataSize * sizeof(float) + alignof(float)
-		+ instanceDataSize * sizeof(float) + alignof(float)
-		+ instanceDataSize * sizeof(Color4) + alignof(Color4)
-		+ instanceDataSize * sizeof(uint32_t) + alignof(uint32_t)
-		;
-
-	LightInstanceData newLightInstanceData;
-	newLightInstanceData.size = this->lightInstanceData.size;
-	newLightInstanceData.capacity = instanceDataSize;
-	newLightInstanceData.buffer = allocator->allocate(bytes);
-
-	newLightInstanceData.unitIdList = (UnitId*)newLightInstanceData.buffer;
-	newLightInstanceData.worldMatrix4x4List = (Matrix4x4*)Memory::getAlignedToTop(newLightInstanceData.unitIdList + instanceDataSize, alignof(Matrix4x4));
-	newLightInstanceData.rangeList = (float*)Memory::getAlignedToTop(newLightInstanceData.worldMatrix4x4List + instanceDataSize, alignof(float));
-	newLightInstanceData.intensityList = (float*)Memory::getAlignedToTop(newLightInstanceData.rangeList + instanceDataSize, alignof(float));
-	newLightInstanceData.spotAngleList = (float*)Memory::getAlignedToTop(newLightInstanceData.intensityList + instanceDataSize, alignof(float));
-	newLightInstanceData.colorList = (Color4*)Memory::getAlignedToTop(newLightInstanceData.spotAngleList + instanceDataSize, alignof(Color4));
-	newLightInstanceData.lightTypeList = (uint32_t*)Memory::getAlignedToTop(newLightInstanceData.colorList + instanceDataSize, alignof(uint32_t));
-
-	memcpy(newLightInstanceData.unitIdList, this->lightInstanceData.unitIdList, this->lightInstanceData.size * sizeof(UnitId));
-	memcpy(newLightInstanceData.worldMatrix4x4List, this->lightInstanceData.worldMatrix4x4List, this->lightInstanceData.size * sizeof(Matrix4x4));
-	memcpy(newLightInstanceData.rangeList, this->lightInstanceData.rangeList, this->lightInstanceData.size * sizeof(float));
-	memcpy(newLightInstanceData.intensityList, this->lightInstanceData.intensityList, this->lightInstanceData.size * sizeof(float));
-	memcpy(newLightInstanceData.spotAngleList, this->lightInstanceData.spotAngleList, this->lightInstanceData.size * sizeof(float));
-	memcpy(newLightInstanceData.colorList, this->lightInstanceData.colorList, this->lightInstanceData.size * sizeof(Color4));
-	memcpy(newLightInstanceData.lightTypeList, this->lightInstanceData.lightTypeList, this->lightInstanceData.size * sizeof(uint32_t));
-
-	allocator->deallocate(this->lightInstanceData.buffer);
-	this->lightInstanceData = newLightInstanceData;
-}
-
-void LightManager::grow()
-{
-	allocate(this->lightInstanceData.capacity * 2 + 1);
-}
-
 LightInstance LightManager::create(UnitId unitId, const LightDesc& lightDesc, const Matrix4x4& transformMatrix4x4)
 {
 	RIO_ASSERT(!HashMapFn::has(this->unitIdToLightInstanceIndexMap, unitId), "Unit already has light");
 
-	if (this->lightInstanceData.size == this->lightInstanceData.capacity)
-	{
-		grow();
-	}
-
-	const uint32_t lastIndex = this->lightInstanceData.size;
+	const uint32_t lastIndex = SoaBufferFn::pushBack(this->lightInstanceData);
 
 	this->lightInstanceData.unitIdList[lastIndex] = unitId;
 	this->lightInstanceData.worldMatrix4x4List[lastIndex] = transformMatrix4x4;
@@ -74,8 +25,6 @@ LightInstance LightManager::create(UnitId unitId, const LightDesc& lightDesc, co
 	this->lightInstanceData.colorList[lastIndex] = createVector4(lightDesc.color.x, lightDesc.color.y, lightDesc.color.z, 1.0f);
 	this->lightInstanceData.lightTypeList[lastIndex] = lightDesc.type;
 
-	++this->lightInstanceData.size;
-
 	HashMapFn::set(this->unitIdToLightInstanceIndexMap, unitId, lastIndex);
 	return makeLightInstance(lastIndex);
 }
@@ -88,15 +37,7 @@ void LightManager::destroy(LightInstance lightInstance)
 	const UnitId unitId = this->lightInstanceData.unitIdList[lightInstance.index];
 	const UnitId lastUnitId = this->lightInstanceData.unitIdList[lastIndex];
 
-	this->lightInstanceData.unitIdList[lightInstance.index] = this->lightInstanceData.unitIdList[lastIndex];
-	this->lightInstanceData.worldMatrix4x4List[lightInstance.index] = this->lightInstanceData.worldMatrix4x4List[lastIndex];
-	this->lightInstanceData.rangeList[lightInstance.index] = this->lightInstanceData.rangeList[lastIndex];
-	this->lightInstanceData.intensityList[lightInstance.index] = this->lightInstanceData.intensityList[lastIndex];
-	this->lightInstanceData.spotAngleList[lightInstance.index] = this->lightInstanceData.spotAngleList[lastIndex];
-	this->lightInstanceData.colorList[lightInstance.index] = this->lightInstanceData.colorList[lastIndex];
-	this->lightInstanceData.lightTypeList[lightInstance.index] = this->lightInstanceData.lightTypeList[lastIndex];
-
-	--this->lightInstanceData.size;
+	SoaBufferFn::swapRemove(this->lightInstanceData, lightInstance.index);
 
 	HashMapFn::set(this->unitIdToLightInstanceIndexMap, lastUnitId, lightInstance.index);
 	HashMapFn::remove(this->unitIdToLightInstanceIndexMap, unitId);
@@ -114,7 +55,7 @@ LightInstance LightManager::getLightInstanceByUnitId(UnitId unitId)
 
 void LightManager::destroy()
 {
-	allocator->deallocate(this->lightInstanceData.buffer);
+	SoaBufferFn::setCapacity(this->lightInstanceData, 0);
 }
 
 void LightManager::debugDraw(uint32_t startIndex, uint32_t count, DebugLine& debugLine)
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Core/Containers/SoaBuffer.h"
 #include "Core/Containers/Types.h"
 #include "Core/Math/Types.h"
+#include "Core/Memory/HugePageAllocator.h"
 #include "Core/Strings/StringId.h"
 
 #include "Resource/Types.h"
@@ -15,12 +17,8 @@ namespace Rio
 
 struct LightManager
 {
-	struct LightInstanceData
+	struct LightInstanceData : public SoaBuffer<UnitId, Matrix4x4, float, float, float, Color4, uint32_t>
 	{
-		uint32_t size = 0;
-		uint32_t capacity = 0;
-		void* buffer = nullptr;
-
 		UnitId* unitIdList = nullptr;
 		Matrix4x4* worldMatrix4x4List = nullptr;
 		float* rangeList = nullptr;
@@ -28,17 +26,33 @@ struct LightManager
 		float* spotAngleList = nullptr;
 		Color4* colorList = nullptr;
 		uint32_t* lightTypeList = nullptr; // LightType::Enum
+
+		LightInstanceData(Allocator& a)
+			: SoaBuffer<UnitId, Matrix4x4, float, float, float, Color4, uint32_t>(a)
+		{
+			SoaBufferFn::bind(*this
+				, this->unitIdList
+				, this->worldMatrix4x4List
+				, this->rangeList
+				, this->intensityList
+				, this->spotAngleList
+				, this->colorList
+				, this->lightTypeList
+				);
+		}
 	};
 
 	Allocator* allocator = nullptr;
+	HugePageAllocator instanceDataAllocator; // Big instance buffers go on huge pages
 	HashMap<UnitId, uint32_t> unitIdToLightInstanceIndexMap;
 	LightInstanceData lightInstanceData;
 
 	LightManager(Allocator& a)
 		: allocator(&a)
+		, instanceDataAllocator(a)
 		, unitIdToLightInstanceIndexMap(a)
+		, lightInstanceData(instanceDataAllocator)
 	{
-		memset(&lightInstanceData, 0, sizeof(lightInstanceData));
 	}
 
 	LightInstance create(UnitId unitId, const LightDesc& lightDesc, const Matrix4x4& transformMatrix4x4);
@@ -46,8 +60,6 @@ struct LightManager
 	bool has(UnitId unitId);
 	LightInstance getLightInstanceByUnitId(UnitId unitId);
 	void debugDraw(uint32_t startIndex, uint32_t count, DebugLine& debugLine);
-	void allocate(uint32_t instanceDataSize);
-	void grow();
 	void destroy();
 
 	LightInstance makeLightInstance(uint32_t index)
@@ -1,66 +1,13 @@
 #include "World/Renderer/MeshManager.h"
 
-#include "Core/Containers/HashMap.h"
+#include "Core/Containers/FlatHashMap.h"
 
 namespace Rio
 {
 
-void MeshManager::allocate(uint32_t count)
-{
-	RIO_ENSURE(count > this->meshInstanceData.size);
-
-	const uint32_t bytes = 0
-		+ count * sizeof(UnitId) + alignof(UnitId)
-		+ count * sizeof(MeshResource*) + alignof(MeshResource*)
-		+ count * sizeof(MeshGeometry*) + alignof(MeshGeometry*)
-		+ count * sizeof(MeshData) + alignof(MeshData)
-		+ count * sizeof(StringId64) + alignof(StringId64)
-		+ count * sizeof(Matrix4x4) + alignof(Matrix4x4)
-		+ count * sizeof(Obb) + alignof(Obb)
-		+ count * sizeof(MeshInstance) + alignof(MeshInstance)
-		;
-
-	MeshInstanceData newMeshInstanceData;
-	newMeshInstanceData.size = this->meshInstanceData.size;
-	newMeshInstanceData.capacity = count;
-	newMeshInstanceData.buffer = allocator->allocate(bytes);
-	newMeshInstanceData.firstHiddenIndex = this->meshInstanceData.firstHiddenIndex;
-
-	newMeshInstanceData.unitIdList = (UnitId*)newMeshInstanceData.buffer;
-	newMeshInstanceData.meshResourceList = (const MeshResource**)Memory::getAlignedToTop(newMeshInstanceData.unitIdList + count, alignof(const MeshResource*));
-	newMeshInstanceData.meshGeometryList = (const MeshGeometry**)Memory::getAlignedToTop(newMeshInstanceData.meshResourceList + count, alignof(const MeshGeometry*));
-	newMeshInstanceData.meshDataList = (MeshData*)Memory::getAlignedToTop(newMeshInstanceData.meshGeometryList + count, alignof(MeshData));
-	newMeshInstanceData.materialNameList = (StringId64*)Memory::getAlignedToTop(newMeshInstanceData.meshDataList + count, alignof(StringId64));
-	newMeshInstanceData.worldMatrix4x4List = (Matrix4x4*)Memory::getAlignedToTop(newMeshInstanceData.materialNameList + count, alignof(Matrix4x4));
-	newMeshInstanceData.obbList = (Obb*)Memory::getAlignedToTop(newMeshInstanceData.worldMatrix4x4List + count, alignof(Obb));
-	newMeshInstanceData.nextMeshInstanceList = (MeshInstance*)Memory::getAlignedToTop(newMeshInstanceData.obbList + count, alignof(MeshInstance));
-
-	memcpy(newMeshInstanceData.unitIdList, this->meshInstanceData.unitIdList, this->meshInstanceData.size * sizeof(UnitId));
-	memcpy(newMeshInstanceData.meshResourceList, this->meshInstanceData.meshResourceList, this->meshInstanceData.size * sizeof(MeshResource*));
-	memcpy(newMeshInstanceData.meshGeometryList, this->meshInstanceData.meshGeometryList, this->meshInstanceData.size * sizeof(MeshGeometry*));
-	memcpy(newMeshInstanceData.meshDataList, this->meshInstanceData.meshDataList, this->meshInstanceData.size * sizeof(MeshData));
-	memcpy(newMeshInstanceData.materialNameList, this->meshInstanceData.materialNameList, this->meshInstanceData.size * sizeof(StringId64));
-	memcpy(newMeshInstanceData.worldMatrix4x4List, this->meshInstanceData.worldMatrix4x4List, this->meshInstanceData.size * sizeof(Matrix4x4));
-	memcpy(newMeshInstanceData.obbList, this->meshInstanceData.obbList, this->meshInstanceData.size * sizeof(Obb));
-	memcpy(newMeshInstanceData.nextMeshInstanceList, this->meshInstanceData.nextMeshInstanceList, this->meshInstanceData.size * sizeof(MeshInstance));
-
-	allocator->deallocate(this->meshInstanceData.buffer);
-	this->meshInstanceData = newMeshInstanceData;
-}
-
-void MeshManager::grow()
-{
-	allocate(this->meshInstanceData.capacity * 2 + 1);
-}
-
 MeshInstance MeshManager::create(UnitId unitId, const MeshResource* meshResource, const MeshGeometry* meshGeometry, StringId64 materialName, const Matrix4x4& transformMatrix4x4)
 {
-	if (this->meshInstanceData.size == this->meshInstanceData.capacity)
-	{
-		grow();
-	}
-
-	const uint32_t lastIndex = this->meshInstanceData.size;
+	const uint32_t lastIndex = SoaBufferFn::pushBack(this->meshInstanceData);
 
 	this->meshInstanceData.unitIdList[lastIndex] = unitId;
 	this->meshInstanceData.meshResourceList[lastIndex] = meshResource;
@@ -72,7 +19,6 @@ MeshInstance MeshManager::create(UnitId unitId, const MeshResource* meshResource
 	this->meshInstanceData.obbList[lastIndex] = meshGeometry->obb;
 	this->meshInstanceData.nextMeshInstanceList[lastIndex] = makeMeshInstance(UINT32_MAX);
 
-	++this->meshInstanceData.size;
 	++this->meshInstanceData.firstHiddenIndex;
 
 	MeshInstance currentMeshInstance = getFirst(unitId);
@@ -100,17 +46,7 @@ void MeshManager::destroy(MeshInstance meshInstance)
 	swapMeshNode(lastMeshInstance, meshInstance);
 	removeMeshNode(firstMeshInstance, meshInstance);
 
-	this->meshInstanceData.unitIdList[meshInstance.index] = this->meshInstanceData.unitIdList[lastIndex];
-	this->meshInstanceData.meshResourceList[meshInstance.index] = this->meshInstanceData.meshResourceList[lastIndex];
-	this->meshInstanceData.meshGeometryList[meshInstance.index] = this->meshInstanceData.meshGeometryList[lastIndex];
-	this->meshInstanceData.meshDataList[meshInstance.index].vertexBufferHandle = this->meshInstanceData.meshDataList[lastIndex].vertexBufferHandle;
-	this->meshInstanceData.meshDataList[meshInstance.index].indexBufferHandle = this->meshInstanceData.meshDataList[lastIndex].indexBufferHandle;
-	this->meshInstanceData.materialNameList[meshInstance.index] = this->meshInstanceData.materialNameList[lastIndex];
-	this->meshInstanceData.worldMatrix4x4List[meshInstance.index] = this->meshInstanceData.worldMatrix4x4List[lastIndex];
-	this->meshInstanceData.obbList[meshInstance.index] = this->meshInstanceData.obbList[lastIndex];
-	this->meshInstanceData.nextMeshInstanceList[meshInstance.index] = this->meshInstanceData.nextMeshInstanceList[lastIndex];
-
-	--this->meshInstanceData.size;
+	SoaBufferFn::swapRemove(this->meshInstanceData, meshInstance.index);
 	--this->meshInstanceData.firstHiddenIndex;
 }
 
@@ -209,7 +145,7 @@ void MeshManager::swapMeshNode(MeshInstance meshInstance, MeshInstance otherMesh
 
 void MeshManager::destroy()
 {
-	allocator->deallocate(this->meshInstanceData.buffer);
+	SoaBufferFn::setCapacity(this->meshInstanceData, 0);
 }
 
 } // namespace Rio
\ No newline at end of file
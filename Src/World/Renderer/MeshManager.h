@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Core/Containers/SoaBuffer.h"
 #include "Core/Containers/Types.h"
 #include "Core/Math/Types.h"
+#include "Core/Memory/HugePageAllocator.h"
 #include "Core/Strings/StringId.h"
 
 #include "Resource/Types.h"
@@ -23,12 +25,8 @@ struct MeshManager
 		RioRenderer::IndexBufferHandle indexBufferHandle;
 	};
 
-	struct MeshInstanceData
+	struct MeshInstanceData : public SoaBuffer<UnitId, const MeshResource*, const MeshGeometry*, MeshData, StringId64, Matrix4x4, Obb, MeshInstance>
 	{
-		uint32_t size = 0;
-		uint32_t capacity = 0;
-		void* buffer = nullptr;
-
 		uint32_t firstHiddenIndex = 0;
 
 		UnitId* unitIdList = nullptr;
@@ -39,21 +37,36 @@ struct MeshManager
 		Matrix4x4* worldMatrix4x4List = nullptr;
 		Obb* obbList = nullptr;
 		MeshInstance* nextMeshInstanceList = nullptr;
+
+		MeshInstanceData(Allocator& a)
+			: SoaBuffer<UnitId, const MeshResource*, const MeshGeometry*, MeshData, StringId64, Matrix4x4, Obb, MeshInstance>(a)
+		{
+			SoaBufferFn::bind(*this
+				, this->unitIdList
+				, this->meshResourceList
+				, this->meshGeometryList
+				, this->meshDataList
+				, this->materialNameList
+				, this->worldMatrix4x4List
+				, this->obbList
+				, this->nextMeshInstanceList
+				);
+		}
 	};
 
 	Allocator* allocator = nullptr;
-	HashMap<UnitId, uint32_t> unitIdToMeshInstanceIndexMap;
+	HugePageAllocator instanceDataAllocator; // Big instance buffers go on huge pages
+	FlatHashMap<UnitId, uint32_t> unitIdToMeshInstanceIndexMap;
 	MeshInstanceData meshInstanceData;
 
 	MeshManager(Allocator& a)
 		: allocator(&a)
+		, instanceDataAllocator(a)
 		, unitIdToMeshInstanceIndexMap(a)
+		, meshInstanceData(instanceDataAllocator)
 	{
-		memset(&(this->meshInstanceData), 0, sizeof(this->meshInstanceData));
 	}
 
-	void allocate(uint32_t count);
-	void grow();
 	MeshInstance create(UnitId unitId, const MeshResource* meshResource, const MeshGeometry* meshGeometry, StringId64 materialName, const Matrix4x4& transformMatrix4x4);
 	void destroy(MeshInstance meshInstance);
 	bool has(UnitId unitId);
@@ -1,10 +1,12 @@
 #include "World/Renderer/RenderWorld.h"
 
+#include "Core/Containers/FlatHashMap.h"
 #include "Core/Containers/HashMap.h"
 #include "Core/Math/Aabb.h"
 #include "Core/Math/Color4.h"
 #include "Core/Math/Intersection.h"
 #include "Core/Math/Matrix4x4.h"
+#include "Core/Thread/ParallelFor.h"
 
 #include "Device/Pipeline.h"
 
@@ -22,6 +24,92 @@
 namespace Rio
 {
 
+namespace RenderWorldInternalFn
+{
+	// Fills the vertices and indices of the sprites in [rangeBegin, rangeEnd), may run on any thread
+	struct FillSpriteVertices
+	{
+		const SpriteManager::SpriteInstanceData* spriteInstanceData;
+		float* vertexData;
+		uint16_t* indexData;
+
+		void operator()(uint32_t rangeBegin, uint32_t rangeEnd) const
+		{
+			float* vertexData = this->vertexData + rangeBegin * 16;
+			uint16_t* indexData = this->indexData + rangeBegin * 6;
+
+			for (uint32_t i = rangeBegin; i < rangeEnd; ++i)
+			{
+				const float* frameData = SpriteResourceFn::getFrameData(spriteInstanceData->spriteResourceList[i], spriteInstanceData->frameIdList[i]);
+
+				float u0 = frameData[2]; // u
+				float v0 = frameData[3]; // v
+
+				float u1 = frameData[6]; // u
+				float v1 = frameData[7]; // v
+
+				float u2 = frameData[10]; // u
+				float v2 = frameData[11]; // v
+
+				float u3 = frameData[14]; // u
+				float v3 = frameData[15]; // v
+
+				if (spriteInstanceData->flipXList[i])
+				{
+					float u = 0.0f;
+					u = u0; 
+					u0 = u1; 
+					u1 = u;
+					u = u2; 
+					u2 = u3; 
+					u3 = u;
+				}
+
+				if (spriteInstanceData->flipYList[i])
+				{
+					float v = 0.0f;
+					v = v0; 
+					v0 = v2; 
+					v2 = v;
+					v = v1; 
+					v1 = v3; 
+					v3 = v;
+				}
+
+				vertexData[0] = frameData[0]; // x
+				vertexData[1] = frameData[1]; // y
+				vertexData[2] = u0;
+				vertexData[3] = v0;
+
+				vertexData[4] = frameData[4]; // x
+				vertexData[5] = frameData[5]; // y
+				vertexData[6] = u1;
+				vertexData[7] = v1;
+
+				vertexData[8] = frameData[8]; // x
+				vertexData[9] = frameData[9]; // y
+				vertexData[10] = u2;
+				vertexData[11] = v2;
+
+				vertexData[12] = frameData[12]; // x
+				vertexData[13] = frameData[13]; // y
+				vertexData[14] = u3;
+				vertexData[15] = v3;
+
+				vertexData += 16;
+
+				*indexData++ = i * 4 + 0;
+				*indexData++ = i * 4 + 1;
+				*indexData++ = i * 4 + 2;
+				*indexData++ = i * 4 + 0;
+				*indexData++ = i * 4 + 2;
+				*indexData++ = i * 4 + 3;
+			}
+		}
+	};
+
+} // namespace RenderWorldInternalFn
+
 static void unitDestroyedCallbackBridge(UnitId unitId, void* userPtr)
 {
 	((RenderWorld*)userPtr)->unitDestroyedCallback(unitId);
@@ -353,24 +441,40 @@ void RenderWorld::updateUnitTransformList(const UnitId* unitListBegin, const Uni
 	SpriteManager::SpriteInstanceData& spriteInstanceData = spriteManager.spriteInstanceData;
 	LightManager::LightInstanceData& lightInstanceData = lightManager.lightInstanceData;
 
-	for (; unitListBegin != unitListEnd; ++unitListBegin, ++worldMatrix4x4List)
+	// Instances are looked up a batch of units at a time, so the map lookups overlap their cache misses
+	const uint32_t BATCH_SIZE = 64;
+	uint32_t meshIndexList[BATCH_SIZE];
+	uint32_t spriteIndexList[BATCH_SIZE];
+	uint32_t lightIndexList[BATCH_SIZE];
+
+	const uint32_t count = uint32_t(unitListEnd - unitListBegin);
+	for (uint32_t first = 0; first < count; first += BATCH_SIZE)
 	{
-		if (meshManager.has(*unitListBegin))
-		{
-			MeshInstance meshInstance = meshManager.getFirst(*unitListBegin);
-			meshInstanceData.worldMatrix4x4List[meshInstance.index] = *worldMatrix4x4List;
-		}
+		const uint32_t batchCount = (count - first < BATCH_SIZE) ? count - first : BATCH_SIZE;
+		const UnitId* unitIdList = unitListBegin + first;
 
-		if (spriteManager.has(*unitListBegin))
-		{
-			SpriteInstance spriteInstance = spriteManager.getSpriteInstanceByUnitId(*unitListBegin);
-			spriteInstanceData.worldMatrix4x4List[spriteInstance.index] = *worldMatrix4x4List;
-		}
+		HashMapFn::getBatch(meshManager.unitIdToMeshInstanceIndexMap, unitIdList, batchCount, meshIndexList, UINT32_MAX);
+		HashMapFn::getBatch(spriteManager.unitIdToSpriteInstanceIndexMap, unitIdList, batchCount, spriteIndexList, UINT32_MAX);
+		HashMapFn::getBatch(lightManager.unitIdToLightInstanceIndexMap, unitIdList, batchCount, lightIndexList, UINT32_MAX);
 
-		if (lightManager.has(*unitListBegin))
+		for (uint32_t i = 0; i < batchCount; ++i)
 		{
-			LightInstance lightInstance = lightManager.getLightInstanceByUnitId(*unitListBegin);
-			lightInstanceData.worldMatrix4x4List[lightInstance.index] = *worldMatrix4x4List;
+			const Matrix4x4& worldMatrix4x4 = worldMatrix4x4List[first + i];
+
+			if (meshIndexList[i] != UINT32_MAX)
+			{
+				meshInstanceData.worldMatrix4x4List[meshIndexList[i]] = worldMatrix4x4;
+			}
+
+			if (spriteIndexList[i] != UINT32_MAX)
+			{
+				spriteInstanceData.worldMatrix4x4List[spriteIndexList[i]] = worldMatrix4x4;
+			}
+
+			if (lightIndexList[i] != UINT32_MAX)
+			{
+				lightInstanceData.worldMatrix4x4List[lightIndexList[i]] = worldMatrix4x4;
+			}
 		}
 	}
 }
@@ -418,77 +522,15 @@ void RenderWorld::render(const Matrix4x4& viewMatrix4x4, const Matrix4x4& projec
 		RioRenderer::TransientIndexBuffer transientIndexBuffer;
 		RioRenderer::allocTransientIndexBuffer(&transientIndexBuffer, 6 * spriteInstanceData.firstHiddenIndex);
 
-		float* vertexData = (float*)transientVertexBuffer.data;
-		uint16_t* indexData = (uint16_t*)transientIndexBuffer.data;
+		RenderWorldInternalFn::FillSpriteVertices fillSpriteVertices;
+		fillSpriteVertices.spriteInstanceData = &spriteInstanceData;
+		fillSpriteVertices.vertexData = (float*)transientVertexBuffer.data;
+		fillSpriteVertices.indexData = (uint16_t*)transientIndexBuffer.data;
+		JobSystemFn::parallelFor(0, spriteInstanceData.firstHiddenIndex, 0, fillSpriteVertices);
 
 		// Render sprites
 		for (uint32_t i = 0; i < spriteInstanceData.firstHiddenIndex; ++i)
 		{
-			const float* frameData = SpriteResourceFn::getFrameData(spriteInstanceData.spriteResourceList[i], spriteInstanceData.frameIdList[i]);
-
-			float u0 = frameData[2]; // u
-			float v0 = frameData[3]; // v
-
-			float u1 = frameData[6]; // u
-			float v1 = frameData[7]; // v
-
-			float u2 = frameData[10]; // u
-			float v2 = frameData[11]; // v
-
-			float u3 = frameData[14]; // u
-			float v3 = frameData[15]; // v
-
-			if (spriteInstanceData.flipXList[i])
-			{
-				float u = 0.0f;
-				u = u0; 
-				u0 = u1; 
-				u1 = u;
-				u = u2; 
-				u2 = u3; 
-				u3 = u;
-			}
-
-			if (spriteInstanceData.flipYList[i])
-			{
-				float v = 0.0f;
-				v = v0; 
-				v0 = v2; 
-				v2 = v;
-				v = v1; 
-				v1 = v3; 
-				v3 = v;
-			}
-
-			vertexData[0] = frameData[0]; // x
-			vertexData[1] = frameData[1]; // y
-			vertexData[2] = u0;
-			vertexData[3] = v0;
-
-			vertexData[4] = frameData[4]; // x
-			vertexData[5] = frameData[5]; // y
-			vertexData[6] = u1;
-			vertexData[7] = v1;
-
-			vertexData[8] = frameData[8]; // x
-			vertexData[9] = frameData[9]; // y
-			vertexData[10] = u2;
-			vertexData[11] = v2;
-
-			vertexData[12] = frameData[12]; // x
-			vertexData[13] = frameData[13]; // y
-			vertexData[14] = u3;
-			vertexData[15] = v3;
-
-			vertexData += 16;
-
-			*indexData++ = i * 4 + 0;
-			*indexData++ = i * 4 + 1;
-			*indexData++ = i * 4 + 2;
-			*indexData++ = i * 4 + 0;
-			*indexData++ = i * 4 + 2;
-			*indexData++ = i * 4 + 3;
-
 			RioRenderer::setTransform(getFloatPtr(spriteInstanceData.worldMatrix4x4List[i]));
 			RioRenderer::setVertexBuffer(0, &transientVertexBuffer);
 			RioRenderer::setIndexBuffer(&transientIndexBuffer, i * 6, 6);
@@ -1,7 +1,7 @@
 #include "World/Renderer/SceneGraph.h"
 
 #include "Core/Containers/Array.h"
-#include "Core/Containers/HashMap.h"
+#include "Core/Containers/FlatHashMap.h"
 #include "Core/Math/Matrix3x3.h"
 #include "Core/Math/Matrix4x4.h"
 #include "Core/Math/Quaternion.h"
@@ -11,7 +11,6 @@
 #include "World/UnitManager.h"
 
 #include <cstdint> // UINT_MAX
-#include <cstring> // memcpy
 
 namespace Rio
 {
@@ -36,7 +35,9 @@ SceneGraph::Pose& SceneGraph::Pose::operator=(const Matrix4x4& matrix4x4)
 
 SceneGraph::SceneGraph(Allocator& a, UnitManager& unitManager)
 	: allocator(&a)
+	, instanceDataAllocator(a)
 	, unitManager(&unitManager)
+	, sceneGraphInstanceData(instanceDataAllocator)
 	, unitIdToTransformInstanceMap(a)
 {
 	unitManager.registerDestroyFunction(unitDestroyedCallbackBridge, this);
@@ -46,8 +47,6 @@ SceneGraph::~SceneGraph()
 {
 	unitManager->unregisterDestroyFunction(this);
 
-	allocator->deallocate(this->sceneGraphInstanceData.buffer);
-
 	marker = 0;
 }
 
@@ -57,43 +56,12 @@ TransformInstance SceneGraph::makeTransformInstance(uint32_t index)
 	return transformInstance;
 }
 
-void SceneGraph::allocate(uint32_t instanceDataSize)
-{
-	RIO_ASSERT(instanceDataSize > this->sceneGraphInstanceData.size, "instanceDataSize > this->sceneGraphInstanceData.size");
-
-	const uint32_t bytes = 0
-		+ instanceDataSize * sizeof(UnitId) + alignof(UnitId)
-		+ instanceDataSize * sizeof(Matrix4x4) + alignof(Matrix4x4)
-		+ instanceDataSize * sizeof(Pose) + alignof(Pose)
-		+ instanceDataSize * sizeof(TransformInstance) * 4 + alignof(TransformInstance)
-		+ instanceDataSize * sizeof(bool) + alignof(bool)
-		;
-
-	SceneGraphInstanceData newSceneGraphInstanceData;
-	newSceneGraphInstanceData.size = this->sceneGraphInstanceData.size;
-	newSceneGraphInstanceData.capacity = instanceDataSize;
-	newSceneGraphInstanceData.buffer = allocator->allocate(bytes);
-
-	newSceneGraphInstanceData.unitIdList = (UnitId*)newSceneGraphInstanceData.buffer;
-	newSceneGraphInstanceData.worldMatrix4x4List = (Matrix4x4*)Memory::getAlignedToTop(newSceneGraphInstanceData.unitIdList + instanceDataSize, alignof(Matrix4x4));
-	newSceneGraphInstanceData.localPoseList = (Pose*)Memory::getAlignedToTop(newSceneGraphInstanceData.worldMatrix4x4List + instanceDataSize, alignof(Pose));
-	newSceneGraphInstanceData.parentTransformInstanceList = (TransformInstance*)Memory::getAlignedToTop(newSceneGraphInstanceData.localPoseList + instanceDataSize, alignof(TransformInstance));
-	newSceneGraphInstanceData.firstChildTransformInstanceList = (TransformInstance*)Memory::getAlignedToTop(newSceneGraphInstanceData.parentTransformInstanceList + instanceDataSize, alignof(TransformInstance));
-	newSceneGraphInstanceData.nextSiblingTransformInstanceList = (TransformInstance*)Memory::getAlignedToTop(newSceneGraphInstanceData.firstChildTransformInstanceList + instanceDataSize, alignof(TransformInstance));
-	newSceneGraphInstanceData.previousSiblingTransformInstanceList = (TransformInstance*)Memory::getAlignedToTop(newSceneGraphInstanceData.nextSiblingTransformInstanceList + instanceDataSize, alignof(TransformInstance));
-	newSceneGraphInstanceData.hasChangedList = (bool*)Memory::getAlignedToTop(newSceneGraphInstanceData.previousSiblingTransformInstanceList + instanceDataSize, alignof(bool));
-
-	memcpy(newSceneGraphInstanceData.unitIdList, this->sceneGraphInstanceData.unitIdList, this->sceneGraphInstanceData.size * sizeof(UnitId));
-	memcpy(newSceneGraphInstanceData.worldMatrix4x4List, this->sceneGraphInstanceData.worldMatrix4x4List, this->sceneGraphInstanceData.size * sizeof(Matrix4x4));
-	memcpy(newSceneGraphInstanceData.localPoseList, this->sceneGraphInstanceData.localPoseList, this->sceneGraphInstanceData.size * sizeof(Pose));
-	memcpy(newSceneGraphInstanceData.parentTransformInstanceList, this->sceneGraphInstanceData.parentTransformInstanceList, this->sceneGraphInstanceData.size * sizeof(TransformInstance));
-	memcpy(newSceneGraphInstanceData.firstChildTransformInstanceList, this->sceneGraphInstanceData.firstChildTransformInstanceList, this->sceneGraphInstanceData.size * sizeof(TransformInstance));
-	memcpy(newSceneGraphInstanceData.nextSiblingTransformInstanceList, this->sceneGraphInstanceData.nextSiblingTransformInstanceList, this->sceneGraphInstanceData.size * sizeof(TransformInstance));
-	memcpy(newSceneGraphInstanceData.previousSiblingTransformInstanceList, this->sceneGraphInstanceData.previousSiblingTransformInstanceList, this->sceneGraphInstanceData.size * sizeof(TransformInstance));
-	memcpy(newSceneGraphInstanceData.hasChangedList, this->sceneGraphInstanceData.hasChangedList, this->sceneGraphInstanceData.size * sizeof(bool));
-
-	allocator->deallocate(this->sceneGraphInstanceData.buffer);
-	this->sceneGraphInstanceData = newSceneGraphInstanceData;
+void SceneGraph::reserve(uint32_t count)
+{
+	const uint32_t size = this->sceneGraphInstanceData.size + count;
+	SoaBufferFn::reserve(this->sceneGraphInstanceData, size);
+
+	HashMapFn::reserve(this->unitIdToTransformInstanceMap, size);
 }
 
 void SceneGraph::unitDestroyedCallback(UnitId unitId)
@@ -119,12 +87,7 @@ TransformInstance SceneGraph::create(UnitId unitId, const Matrix4x4& pose)
 {
 	RIO_ASSERT(!HashMapFn::has(unitIdToTransformInstanceMap, unitId), "Unit already has transform");
 
-	if (this->sceneGraphInstanceData.capacity == this->sceneGraphInstanceData.size)
-	{
-		grow();
-	}
-
-	const uint32_t lastIndex = this->sceneGraphInstanceData.size;
+	const uint32_t lastIndex = SoaBufferFn::pushBack(this->sceneGraphInstanceData);
 
 	this->sceneGraphInstanceData.unitIdList[lastIndex] = unitId;
 	this->sceneGraphInstanceData.worldMatrix4x4List[lastIndex] = pose;
@@ -135,8 +98,6 @@ TransformInstance SceneGraph::create(UnitId unitId, const Matrix4x4& pose)
 	this->sceneGraphInstanceData.previousSiblingTransformInstanceList[lastIndex].index = UINT32_MAX;
 	this->sceneGraphInstanceData.hasChangedList[lastIndex] = false;
 
-	++this->sceneGraphInstanceData.size;
-
 	HashMapFn::set(unitIdToTransformInstanceMap, unitId, lastIndex);
 
 	return makeTransformInstance(lastIndex);
@@ -151,19 +112,10 @@ void SceneGraph::destroy(UnitId unitId, TransformInstance /*unitTransformInstanc
 	const UnitId unitIdLocal = this->sceneGraphInstanceData.unitIdList[transformInstance.index];
 	const UnitId lastUnitId = this->sceneGraphInstanceData.unitIdList[lastIndex];
 
-	this->sceneGraphInstanceData.unitIdList[transformInstance.index] = this->sceneGraphInstanceData.unitIdList[lastIndex];
-	this->sceneGraphInstanceData.worldMatrix4x4List[transformInstance.index] = this->sceneGraphInstanceData.worldMatrix4x4List[lastIndex];
-	this->sceneGraphInstanceData.localPoseList[transformInstance.index] = this->sceneGraphInstanceData.localPoseList[lastIndex];
-	this->sceneGraphInstanceData.parentTransformInstanceList[transformInstance.index] = this->sceneGraphInstanceData.parentTransformInstanceList[lastIndex];
-	this->sceneGraphInstanceData.firstChildTransformInstanceList[transformInstance.index]  = this->sceneGraphInstanceData.firstChildTransformInstanceList[lastIndex];
-	this->sceneGraphInstanceData.nextSiblingTransformInstanceList[transformInstance.index] = this->sceneGraphInstanceData.nextSiblingTransformInstanceList[lastIndex];
-	this->sceneGraphInstanceData.previousSiblingTransformInstanceList[transformInstance.index] = this->sceneGraphInstanceData.previousSiblingTransformInstanceList[lastIndex];
-	this->sceneGraphInstanceData.hasChangedList[transformInstance.index] = this->sceneGraphInstanceData.hasChangedList[lastIndex];
+	SoaBufferFn::swapRemove(this->sceneGraphInstanceData, transformInstance.index);
 
 	HashMapFn::set(unitIdToTransformInstanceMap, lastUnitId, transformInstance.index);
 	HashMapFn::remove(unitIdToTransformInstanceMap, unitIdLocal);
-
-	--this->sceneGraphInstanceData.size;
 }
 
 TransformInstance SceneGraph::getTransformInstanceByUnitId(UnitId unitId)
@@ -402,9 +354,4 @@ void SceneGraph::transform(const Matrix4x4& parentMatrix4x4, TransformInstance t
 	}
 }
 
-void SceneGraph::grow()
-{
-	allocate(this->sceneGraphInstanceData.capacity * 2 + 1);
-}
-
 } // namespace Rio
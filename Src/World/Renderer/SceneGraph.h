@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Core/Containers/SoaBuffer.h"
 #include "Core/Containers/Types.h"
 #include "Core/Math/Types.h"
+#include "Core/Memory/HugePageAllocator.h"
 #include "Core/Memory/Types.h"
 #include "Core/Types.h"
 
@@ -22,16 +24,8 @@ struct SceneGraph
 		Pose& operator=(const Matrix4x4& matrix4x4);
 	};
 
-	struct SceneGraphInstanceData
+	struct SceneGraphInstanceData : public SoaBuffer<UnitId, Matrix4x4, Pose, TransformInstance, TransformInstance, TransformInstance, TransformInstance, bool>
 	{
-		SceneGraphInstanceData()
-		{
-		}
-
-		uint32_t size = 0;
-		uint32_t capacity = 0;
-		void* buffer = nullptr;
-
 		UnitId* unitIdList = nullptr;
 		Matrix4x4* worldMatrix4x4List = nullptr;
 		Pose* localPoseList = nullptr;
@@ -40,13 +34,29 @@ struct SceneGraph
 		TransformInstance* nextSiblingTransformInstanceList = nullptr;
 		TransformInstance* previousSiblingTransformInstanceList = nullptr;
 		bool* hasChangedList = nullptr;
+
+		SceneGraphInstanceData(Allocator& a)
+			: SoaBuffer<UnitId, Matrix4x4, Pose, TransformInstance, TransformInstance, TransformInstance, TransformInstance, bool>(a)
+		{
+			SoaBufferFn::bind(*this
+				, this->unitIdList
+				, this->worldMatrix4x4List
+				, this->localPoseList
+				, this->parentTransformInstanceList
+				, this->firstChildTransformInstanceList
+				, this->nextSiblingTransformInstanceList
+				, this->previousSiblingTransformInstanceList
+				, this->hasChangedList
+				);
+		}
 	};
 
 	uint32_t marker = SCENE_GRAPH_MARKER;
 	Allocator* allocator = nullptr;
+	HugePageAllocator instanceDataAllocator; // Big instance buffers go on huge pages
 	UnitManager* unitManager = nullptr;
 	SceneGraphInstanceData sceneGraphInstanceData;
-	HashMap<UnitId, uint32_t> unitIdToTransformInstanceMap;
+	FlatHashMap<UnitId, uint32_t> unitIdToTransformInstanceMap;
 
 	SceneGraph(Allocator& a, UnitManager& unitManager);
 	~SceneGraph();
@@ -57,6 +67,9 @@ struct SceneGraph
 	// Creates a new transform instance for unit <unitId>
 	TransformInstance create(UnitId unitId, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
 
+	// Makes room for <count> more transform instances, so creating them does not rehash or grow on the way
+	void reserve(uint32_t count);
+
 	// Destroys the transform for the <unitId>
 	// The transform is ignored
 	void destroy(UnitId unitId, TransformInstance transformInstance);
@@ -100,8 +113,6 @@ struct SceneGraph
 	void getAreChanged(Array<UnitId>& unitList, Array<Matrix4x4>& worldPoseList);
 	void setLocal(TransformInstance transformInstance);
 	void transform(const Matrix4x4& parentMatrix4x4, TransformInstance transformInstance);
-	void grow();
-	void allocate(uint32_t instanceDataSize);
 	TransformInstance makeTransformInstance(uint32_t index);
 	void unitDestroyedCallback(UnitId unitId);
 };
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Core/Containers/SoaBuffer.h"
 #include "Core/Containers/Types.h"
 #include "Core/Math/Types.h"
+#include "Core/Memory/HugePageAllocator.h"
 #include "Core/Strings/StringId.h"
 
 #include "Resource/Types.h"
@@ -14,12 +16,8 @@ namespace Rio
 {
 	struct SpriteManager
 	{
-		struct SpriteInstanceData
+		struct SpriteInstanceData : public SoaBuffer<UnitId, const SpriteResource*, StringId64, uint32_t, Matrix4x4, Aabb, bool, bool, uint32_t, uint32_t, SpriteInstance>
 		{
-			uint32_t size = 0;
-			uint32_t capacity = 0;
-			void* buffer = nullptr;
-
 			uint32_t firstHiddenIndex = 0;
 
 			UnitId* unitIdList = nullptr;
@@ -33,25 +31,43 @@ namespace Rio
 			uint32_t* layerList = nullptr;
 			uint32_t* depthList = nullptr;
 			SpriteInstance* nextSpriteInstanceList = nullptr;
+
+			SpriteInstanceData(Allocator& a)
+				: SoaBuffer<UnitId, const SpriteResource*, StringId64, uint32_t, Matrix4x4, Aabb, bool, bool, uint32_t, uint32_t, SpriteInstance>(a)
+			{
+				SoaBufferFn::bind(*this
+					, this->unitIdList
+					, this->spriteResourceList
+					, this->materialNameList
+					, this->frameIdList
+					, this->worldMatrix4x4List
+					, this->aabbList
+					, this->flipXList
+					, this->flipYList
+					, this->layerList
+					, this->depthList
+					, this->nextSpriteInstanceList
+					);
+			}
 		};
 
 		Allocator* allocator = nullptr;
+		HugePageAllocator instanceDataAllocator; // Big instance buffers go on huge pages
 		HashMap<UnitId, uint32_t> unitIdToSpriteInstanceIndexMap;
 		SpriteInstanceData spriteInstanceData;
 
 		SpriteManager(Allocator& a)
 			: allocator(&a)
+			, instanceDataAllocator(a)
 			, unitIdToSpriteInstanceIndexMap(a)
+			, spriteInstanceData(instanceDataAllocator)
 		{
-			memset(&spriteInstanceData, 0, sizeof(spriteInstanceData));
 		}
 
 		SpriteInstance create(UnitId unitId, const SpriteResource* spriteResource, StringId64 materialName, uint32_t layer, uint32_t depth, const Matrix4x4& transformMatrix4x4);
 		void destroy(SpriteInstance spriteInstance);
 		bool has(UnitId unitId);
 		SpriteInstance getSpriteInstanceByUnitId(UnitId unitId);
-		void allocate(uint32_t itemListCount);
-		void grow();
 		void destroy();
 
 		SpriteInstance makeSpriteInstance(uint32_t index)
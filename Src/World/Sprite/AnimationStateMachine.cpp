@@ -1,7 +1,7 @@
 #include "World/Sprite/AnimationStateMachine.h"
 
 #include "Core/Containers/Array.h"
-#include "Core/Containers/HashMap.h"
+#include "Core/Containers/FlatHashMap.h"
 #include "Core/Containers/Types.h"
 
 #include "Resource/Sprite/ExpressionLanguage.h"
@@ -15,6 +15,21 @@
 namespace Rio
 {
 
+namespace AnimationStateMachineInternalFn
+{
+	struct UpdateRange
+	{
+		AnimationStateMachine* animationStateMachine;
+		float dt;
+
+		void operator()(uint32_t rangeBegin, uint32_t rangeEnd) const
+		{
+			animationStateMachine->updateRange(rangeBegin, rangeEnd, dt);
+		}
+	};
+
+} // namespace AnimationStateMachineInternalFn
+
 static void unitDestroyedCallbackBridge(UnitId unitId, void* userPtr)
 {
 	((AnimationStateMachine*)userPtr)->unitDestroyedCallback(unitId);
@@ -26,6 +41,9 @@ AnimationStateMachine::AnimationStateMachine(Allocator& a, ResourceManager& reso
 	, animationIndexMap(a)
 	, animationList(a)
 	, eventStream(a)
+	, variableListPool(a, MAX_POOLED_VARIABLE_COUNT * sizeof(float), alignof(float))
+	, frameChangeEventOutput(a)
+	, frameChangeEventList(a)
 {
 	unitManager.registerDestroyFunction(unitDestroyedCallbackBridge, this);
 }
@@ -52,7 +70,7 @@ uint32_t AnimationStateMachine::create(UnitId unitId, const AnimationStateMachin
 	animation.state = StateMachineFn::getInitialState(stateMachineResource);
 	animation.stateNext = nullptr;
 	animation.stateMachineResource = stateMachineResource;
-	animation.variableList = (float*)getDefaultAllocator().allocate(sizeof(*animation.variableList) * stateMachineResource->variableListCount);
+	animation.variableList = (float*)getVariableListAllocator(stateMachineResource->variableListCount).allocate(sizeof(*animation.variableList) * stateMachineResource->variableListCount, alignof(float));
 
 	memcpy(animation.variableList, StateMachineFn::getVariableList(stateMachineResource), sizeof(*animation.variableList)*stateMachineResource->variableListCount);
 
@@ -69,7 +87,7 @@ void AnimationStateMachine::destroy(UnitId unitId)
 	const uint32_t lastAnimationIndex = ArrayFn::getCount(this->animationList) - 1;
 	const UnitId lastUnitId = this->animationList[lastAnimationIndex].unitId;
 
-	getDefaultAllocator().deallocate(this->animationList[animationIndex].variableList);
+	getVariableListAllocator(this->animationList[animationIndex].stateMachineResource->variableListCount).deallocate(this->animationList[animationIndex].variableList);
 	this->animationList[animationIndex] = this->animationList[lastAnimationIndex];
 
 	ArrayFn::popBack(this->animationList);
@@ -139,13 +157,35 @@ void AnimationStateMachine::trigger(UnitId unitId, StringId32 eventName)
 }
 
 void AnimationStateMachine::update(float dt)
+{
+	ParallelOutputFn::clear(this->frameChangeEventOutput);
+
+	AnimationStateMachineInternalFn::UpdateRange updateRangeFunction;
+	updateRangeFunction.animationStateMachine = this;
+	updateRangeFunction.dt = dt;
+
+	// Autoload may load a missing resource, which cannot be done from several threads at once
+	const uint32_t animationListCount = ArrayFn::getCount(this->animationList);
+	const uint32_t grainSize = resourceManager->autoloadEnabled ? animationListCount : 0;
+	JobSystemFn::parallelFor(0, animationListCount, grainSize, updateRangeFunction);
+
+	// Emit events in the order of the animations
+	ArrayFn::clear(this->frameChangeEventList);
+	ParallelOutputFn::merge(this->frameChangeEventOutput, this->frameChangeEventList);
+	for (uint32_t i = 0; i < ArrayFn::getCount(this->frameChangeEventList); ++i)
+	{
+		EventStreamFn::write(this->eventStream, 0, this->frameChangeEventList[i]);
+	}
+}
+
+void AnimationStateMachine::updateRange(uint32_t rangeBegin, uint32_t rangeEnd, float dt)
 {
 	const uint32_t stackSize = 32;
 	float stackData[stackSize];
 
 	ExpressionLanguageFn::Stack stack(stackData, stackSize);
 
-	for (uint32_t i = 0; i < ArrayFn::getCount(this->animationList); ++i)
+	for (uint32_t i = rangeBegin; i < rangeEnd; ++i)
 	{
 		Animation& animationCurrent = this->animationList[i];
 
@@ -232,7 +272,7 @@ void AnimationStateMachine::update(float dt)
 		SpriteFrameChangeEvent spriteFrameChangeEvent;
 		spriteFrameChangeEvent.unitId = animationCurrent.unitId;
 		spriteFrameChangeEvent.frameId = animationCurrent.frameList[animationFrameIndex];
-		EventStreamFn::write(this->eventStream, 0, spriteFrameChangeEvent);
+		ParallelOutputFn::write(this->frameChangeEventOutput, rangeBegin, spriteFrameChangeEvent);
 	}
 }
 
@@ -244,4 +284,13 @@ void AnimationStateMachine::unitDestroyedCallback(UnitId unitId)
 	}
 }
 
+Allocator& AnimationStateMachine::getVariableListAllocator(uint32_t variableListCount)
+{
+	if (variableListCount <= MAX_POOLED_VARIABLE_COUNT)
+	{
+		return this->variableListPool;
+	}
+	return getDefaultAllocator();
+}
+
 } // namespace Rio
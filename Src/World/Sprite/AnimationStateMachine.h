@@ -2,6 +2,8 @@
 
 #include "Core/Containers/EventStream.h"
 #include "Core/Containers/Types.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Thread/ParallelFor.h"
 
 #include "Resource/Sprite/StateMachineResource.h"
 #include "Resource/Types.h"
@@ -33,13 +35,19 @@ struct AnimationStateMachine
 		float* variableList = nullptr;
 	};
 
+	// Variable lists up to this size come from variableListPool, bigger ones from the default allocator
+	static const uint32_t MAX_POOLED_VARIABLE_COUNT = 16;
+
 	uint32_t marker = ANIMATION_STATE_MACHINE_MARKER;
 	ResourceManager* resourceManager = nullptr;
 	UnitManager* unitManager = nullptr;
 
-	HashMap<UnitId, uint32_t> animationIndexMap;
+	FlatHashMap<UnitId, uint32_t> animationIndexMap;
 	Array<Animation> animationList;
 	EventStream eventStream;
+	PoolAllocator variableListPool;
+	ParallelOutput<SpriteFrameChangeEvent> frameChangeEventOutput; // Written by updateRange() on every thread
+	Array<SpriteFrameChangeEvent> frameChangeEventList;
 
 	AnimationStateMachine(Allocator& a, ResourceManager& resourceManager, UnitManager& unitManager);
 	~AnimationStateMachine();
@@ -53,7 +61,11 @@ struct AnimationStateMachine
 	void setVariable(UnitId unitId, uint32_t variableId, float floatValue);
 	void trigger(UnitId unitId, StringId32 eventName);
 	void update(float dt);
+	// Updates the animations in [rangeBegin, rangeEnd), may run on any thread
+	void updateRange(uint32_t rangeBegin, uint32_t rangeEnd, float dt);
 	void unitDestroyedCallback(UnitId unitId);
+	// Returns the allocator of the variable list of a state machine with <variableListCount> variables
+	Allocator& getVariableListAllocator(uint32_t variableListCount);
 };
 
 } // namespace Rio
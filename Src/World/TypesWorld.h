@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Config.h"
+#include "Core/Functional.h"
 #include <cstdint> // uint32_t
 
 namespace Rio
@@ -41,9 +42,11 @@ namespace Rio
 	template <>
 	struct Hash<UnitId>
 	{
+		HASH_IS_MIXED;
+
 		uint32_t operator()(const UnitId& id) const
 		{
-			return id.unitIndex;
+			return HashFn::mix(id.unitIndex);
 		}
 	};
 } // namespace Rio
\ No newline at end of file
@@ -1,11 +1,11 @@
 #include "World/World.h"
 
 #include "Core/Containers/HashMap.h"
+#include "Core/Containers/SmallArray.h"
 #include "Core/Error/Error.h"
 #include "Core/Math/Matrix4x4.h"
 #include "Core/Math/Vector3.h"
 #include "Core/Math/Vector4.h"
-#include "Core/Memory/TempAllocator.h"
 
 #if AMSTEL_ENGINE_SCRIPT_LUA
 #include "Script/LuaEnvironment.h"
@@ -38,8 +38,9 @@ namespace Rio
 {
 
 #if AMSTEL_ENGINE_SCRIPT_LUA
-World::World(Allocator& a, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager, LuaEnvironment& luaEnvironment)
+World::World(Allocator& a, Allocator& frameAllocator, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager, LuaEnvironment& luaEnvironment)
 	: allocator(&a)
+	, frameAllocator(&frameAllocator)
 	, resourceManager(&resourceManager)
 	, shaderManager(&shaderManager)
 	, materialManager(&materialManager)
@@ -77,8 +78,9 @@ World::World(Allocator& a, ResourceManager& resourceManager, ShaderManager& shad
 
 #else
 
-World::World(Allocator& a, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager)
+World::World(Allocator& a, Allocator& frameAllocator, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager)
 	: allocator(&a)
+	, frameAllocator(&frameAllocator)
 
 	, resourceManager(&resourceManager)
 	, shaderManager(&shaderManager)
@@ -226,9 +228,8 @@ void World::updateScene(float dt)
 		ArrayFn::clear(eventStream);
 	}
 
-	TempAllocator4096 tempAllocator4096;
-	Array<UnitId> changedUnitList(tempAllocator4096);
-	Array<Matrix4x4> changedWorldMatrix4x4List(tempAllocator4096);
+	SmallArray<UnitId, 64> changedUnitList(*(this->frameAllocator));
+	SmallArray<Matrix4x4, 64> changedWorldMatrix4x4List(*(this->frameAllocator));
 
 	this->sceneGraph->getAreChanged(changedUnitList, changedWorldMatrix4x4List);
 
@@ -653,6 +654,7 @@ void spawnUnitList(World& world, const UnitResource& unitResource, const Vector3
 		if (componentData->type == COMPONENT_TYPE_TRANSFORM)
 		{
 			const TransformDesc* transformDescList = (const TransformDesc*)componentDataBufferBegin;
+			world.sceneGraph->reserve(componentData->instanceListCount);
 			for (uint32_t i = 0, n = componentData->instanceListCount; i < n; ++i, ++transformDescList)
 			{
 				Matrix4x4 unitMatrix4x4 = createMatrix4x4(rotation, position);
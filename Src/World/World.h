@@ -45,6 +45,7 @@ struct World
 
 	uint32_t marker = WORLD_MARKER;
 	Allocator* allocator = nullptr;
+	Allocator* frameAllocator = nullptr; // Memory valid until the end of the next frame
 
 	ResourceManager* resourceManager = nullptr;
 	
@@ -93,9 +94,9 @@ struct World
 	}
 
 #if AMSTEL_ENGINE_SCRIPT_LUA
-	World(Allocator& a, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager, LuaEnvironment& luaEnvironment);
+	World(Allocator& a, Allocator& frameAllocator, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager, LuaEnvironment& luaEnvironment);
 #else
-	World(Allocator& a, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager);
+	World(Allocator& a, Allocator& frameAllocator, ResourceManager& resourceManager, ShaderManager& shaderManager, MaterialManager& materialManager, UnitManager& unitManager);
 #endif // AMSTEL_ENGINE_SCRIPT_LUA
 	~World();
 